@@ -19,6 +19,7 @@
 #include "hpolytope.h"
 #include "vpolytope.h"
 #include "zpolytope.h"
+#include "zonotope_facets.h"
 #include "samplers.h"
 #include "gaussian_samplers.h"
 #include "sample_only.h"
@@ -106,7 +107,7 @@ Rcpp::NumericMatrix sample_points(Rcpp::Nullable<Rcpp::Reference> P = R_NilValue
     NT radius = 1.0, delta = -1.0, diam = -1.0;
     bool set_mean_point = false, cdhr = false, rdhr = false, ball_walk = false, gaussian = false,
           billiard = false, boundary = false;
-    std::list<Point> randPoints;
+    PointStore<Point> randPoints;
     std::pair<Point, NT> InnerBall;
 
     Point shift(dim);
@@ -139,16 +140,18 @@ Rcpp::NumericMatrix sample_points(Rcpp::Nullable<Rcpp::Reference> P = R_NilValue
                 throw Rcpp::exception("The kind of body has to be given as input!");
 
             }
+            unsigned seed = std::chrono::system_clock::now().time_since_epoch().count();
+            RNGType rng(seed);
             if (Rcpp::as<std::string>(Rcpp::as<Rcpp::List>(known_body)["body"]).compare(std::string("hypersphere"))==0) {
 
                 for (unsigned int k = 0; k < numpoints; ++k) {
-                    randPoints.push_back(get_point_on_Dsphere<RNGType , Point >(dim, radius));
+                    randPoints.push_back(get_point_on_Dsphere<RNGType , Point >(dim, radius, rng));
                 }
 
             } else if (Rcpp::as<std::string>(Rcpp::as<Rcpp::List>(known_body)["body"]).compare(std::string("ball"))==0) {
 
                 for (unsigned int k = 0; k < numpoints; ++k) {
-                    randPoints.push_back(get_point_in_Dsphere<RNGType , Point >(dim, radius));
+                    randPoints.push_back(get_point_in_Dsphere<RNGType , Point >(dim, radius, rng));
                 }
 
             } else if (Rcpp::as<std::string>(Rcpp::as<Rcpp::List>(known_body)["body"]).compare(std::string("unit simplex"))==0) {
@@ -261,12 +264,19 @@ Rcpp::NumericMatrix sample_points(Rcpp::Nullable<Rcpp::Reference> P = R_NilValue
         boost::random::uniform_real_distribution<>(urdist);
         boost::random::uniform_real_distribution<> urdist1(-1,1);
 
+        if (type == 1) {
+            HP.init(dim, Rcpp::as<MT>(Rcpp::as<Rcpp::Reference>(P).field("A")),
+                    Rcpp::as<VT>(Rcpp::as<Rcpp::Reference>(P).field("b")));
+        } else if (type == 3) {
+            ZP.init(dim, Rcpp::as<MT>(Rcpp::as<Rcpp::Reference>(P).field("G")),
+                    VT::Ones(Rcpp::as<MT>(Rcpp::as<Rcpp::Reference>(P).field("G")).rows()));
+            // a zonotope with few facets is sampled through its H-representation, without LPs
+            if (zonotope_as_hpoly(ZP, HP)) type = 1;
+        }
+
         switch(type) {
             case 1: {
                 // Hpolytope
-                HP.init(dim, Rcpp::as<MT>(Rcpp::as<Rcpp::Reference>(P).field("A")),
-                        Rcpp::as<VT>(Rcpp::as<Rcpp::Reference>(P).field("b")));
-
                 if (!set_mean_point || ball_walk || billiard) {
                     InnerBall = HP.ComputeInnerBall();
                     if (!set_mean_point) MeanPoint = InnerBall.first;
@@ -277,7 +287,7 @@ Rcpp::NumericMatrix sample_points(Rcpp::Nullable<Rcpp::Reference> P = R_NilValue
                 HP.normalize();
                 if (gaussian) {
                     shift = MeanPoint;
-                    HP.shift(Eigen::Map<VT>(&MeanPoint.get_coeffs()[0], MeanPoint.dimension()));
+                    HP.shift(MeanPoint.map());
                     MeanPoint = Point(dim);
                 }
                 break;
@@ -296,16 +306,13 @@ Rcpp::NumericMatrix sample_points(Rcpp::Nullable<Rcpp::Reference> P = R_NilValue
                 if (billiard && diam < 0.0) VP.comp_diam(diam, 0.0);
                 if (gaussian) {
                     shift = MeanPoint;
-                    VP.shift(Eigen::Map<VT>(&MeanPoint.get_coeffs()[0], MeanPoint.dimension()));
+                    VP.shift(MeanPoint.map());
                     MeanPoint = Point(dim);
                 }
                 break;
             }
             case 3: {
                 // Zonotope
-                ZP.init(dim, Rcpp::as<MT>(Rcpp::as<Rcpp::Reference>(P).field("G")),
-                        VT::Ones(Rcpp::as<MT>(Rcpp::as<Rcpp::Reference>(P).field("G")).rows()));
-
                 if (!set_mean_point || ball_walk) {
                     InnerBall = ZP.ComputeInnerBall();
                     if (!set_mean_point) MeanPoint = InnerBall.first;
@@ -315,7 +322,7 @@ Rcpp::NumericMatrix sample_points(Rcpp::Nullable<Rcpp::Reference> P = R_NilValue
                 if (billiard && diam < 0.0) ZP.comp_diam(diam, 0.0);
                 if (gaussian) {
                     shift = MeanPoint;
-                    ZP.shift(Eigen::Map<VT>(&MeanPoint.get_coeffs()[0], MeanPoint.dimension()));
+                    ZP.shift(MeanPoint.map());
                     MeanPoint = Point(dim);
                 }
                 break;
@@ -340,7 +347,7 @@ Rcpp::NumericMatrix sample_points(Rcpp::Nullable<Rcpp::Reference> P = R_NilValue
                 }
                 if (gaussian) {
                     shift = MeanPoint;
-                    VPcVP.shift(Eigen::Map<VT>(&MeanPoint.get_coeffs()[0], MeanPoint.dimension()));
+                    VPcVP.shift(MeanPoint.map());
                     MeanPoint = Point(dim);
                 }
                 break;
@@ -389,17 +396,13 @@ Rcpp::NumericMatrix sample_points(Rcpp::Nullable<Rcpp::Reference> P = R_NilValue
 
     }
 
-    if (numpoints % 2 == 1 && boundary) numpoints--;
-    MT RetMat(dim, numpoints);
-    unsigned int jj = 0;
-
-    for (typename std::list<Point>::iterator rpit = randPoints.begin(); rpit!=randPoints.end(); rpit++, jj++) {
-        if (gaussian) {
-            RetMat.col(jj) = Eigen::Map<VT>(&(*rpit).get_coeffs()[0], (*rpit).dimension()) + Eigen::Map<VT>(&shift.get_coeffs()[0], shift.dimension());
-        } else {
-            RetMat.col(jj) = Eigen::Map<VT>(&(*rpit).get_coeffs()[0], (*rpit).dimension());
-        }
+    // the samples are stored contiguously column by column, so they are copied to R's memory at once
+    Rcpp::NumericMatrix RetMat(randPoints.dimension(), randPoints.size());
+    std::copy(randPoints.data(), randPoints.data() + randPoints.dimension() * randPoints.size(), RetMat.begin());
+    if (gaussian) {
+        Eigen::Map<MT>(RetMat.begin(), randPoints.dimension(), randPoints.size()).colwise() +=
+                shift.map();
     }
-    return Rcpp::wrap(RetMat);
+    return RetMat;
 
 }
@@ -10,44 +10,39 @@
 #define TOL 0.00000000001
 
 
-template <typename Point, typename ConvexBody, typename PointList, typename NT>
-bool check_convergence(ConvexBody &P, PointList &randPoints, const NT &lb, const NT &ub, bool &too_few, NT &ratio,
-                      const int &nu, NT alpha, const bool &precheck, const bool &lastball) {
-
-    std::vector<NT> ratios;
-    std::pair<NT,NT> mv;
-    int m = randPoints.size()/nu, i = 1;
-    NT T, rs, alpha_check = 0.01;
-    size_t countsIn = 0;
+// The t-test of check_convergence with precheck, after the ratio of a new batch is pushed to ratios.
+// Returns true if the ratios so far are clearly below lb (then too_few is set) or above ub.
+template <typename NT>
+bool precheck_fails(std::vector<NT> &ratios, const NT &lb, const NT &ub, bool &too_few, NT &ratio) {
+
+    if (ratios.size() < 2) return false;
+    const NT alpha_check = 0.01;
+    boost::math::students_t dist(ratios.size() - 1);
+    std::pair<NT,NT> mv = getMeanVariance(ratios);
+    ratio = mv.first;
+    NT rs = std::sqrt(mv.second);
+    NT T = rs * (boost::math::quantile(boost::math::complement(dist, alpha_check / 2.0))
+                 / std::sqrt(NT(ratios.size())));
+    if (ratio + T < lb) {
+        too_few = true;
+        return true;
+    }
+    return ratio - T > ub;
+}
 
-    for(typename std::list<Point>::iterator pit=randPoints.begin(); pit!=randPoints.end(); ++pit, i++){
 
-        if (P.is_in(*pit)==-1) countsIn++;
-        if (i % m == 0) {
-            ratios.push_back(NT(countsIn)/m);
-            countsIn = 0;
-            if (ratios.size()>1 && precheck) {
-                boost::math::students_t dist(ratios.size() - 1);
-                mv = getMeanVariance(ratios);
-                ratio = mv.first;
-                rs = std::sqrt(mv.second);
-                T = rs * (boost::math::quantile(boost::math::complement(dist, alpha_check / 2.0))
-                          / std::sqrt(NT(ratios.size())));
-                if (ratio + T < lb) {
-                    too_few = true;
-                    return false;
-                } else if (ratio - T > ub) return false;
-            }
-        }
-    }
+// The final t-test of check_convergence on the ratios of the nu batches
+template <typename NT>
+bool test_batch_ratios(std::vector<NT> &ratios, const NT &lb, const NT &ub, bool &too_few, NT &ratio,
+                       const int &nu, NT alpha, const bool &precheck, const bool &lastball) {
 
     //NT alpha = 0.25;
     if(precheck) alpha *= 0.5;
-    mv = getMeanVariance(ratios);
+    std::pair<NT,NT> mv = getMeanVariance(ratios);
     ratio = mv.first;
-    rs = std::sqrt(mv.second);
+    NT rs = std::sqrt(mv.second);
     boost::math::students_t dist(nu - 1);
-    T = rs*(boost::math::quantile(boost::math::complement(dist, alpha))
+    NT T = rs*(boost::math::quantile(boost::math::complement(dist, alpha))
             / std::sqrt(NT(nu)));
     if (ratio > lb + T) {
         if (lastball) return true;
@@ -56,24 +51,126 @@ bool check_convergence(ConvexBody &P, PointList &randPoints, const NT &lb, const
     }
     too_few = true;
     return false;
+}
+
+
+// The test of check_convergence on N points split into nu batches, where in(i) tells if the i-th point
+// lies in the body. With precheck the points of a batch are tested only if the previous batches pass.
+template <typename NT, typename Membership>
+bool check_convergence_batches(const unsigned int N, Membership in, const NT &lb, const NT &ub, bool &too_few,
+                               NT &ratio, const int &nu, const NT &alpha, const bool &precheck, const bool &lastball) {
+
+    std::vector<NT> ratios;
+    int m = N/nu, i = 1;
+    size_t countsIn = 0;
 
+    for(unsigned int j = 0; j < N; ++j, i++){
+
+        if (in(j)) countsIn++;
+        if (i % m == 0) {
+            ratios.push_back(NT(countsIn)/m);
+            countsIn = 0;
+            if (precheck && precheck_fails(ratios, lb, ub, too_few, ratio)) return false;
+        }
+    }
+
+    return test_batch_ratios(ratios, lb, ub, too_few, ratio, nu, alpha, precheck, lastball);
 }
 
 
+template <typename Point, typename ConvexBody, typename PointList, typename NT>
+bool check_convergence(ConvexBody &P, PointList &randPoints, const NT &lb, const NT &ub, bool &too_few, NT &ratio,
+                      const int &nu, NT alpha, const bool &precheck, const bool &lastball) {
+
+    Point q(randPoints.dimension());
+    return check_convergence_batches(randPoints.size(), [&](const unsigned int j) -> bool {
+        randPoints.get_point(j, q);
+        return P.is_in(q) == -1;
+    }, lb, ub, too_few, ratio, nu, alpha, precheck, lastball);
+}
+
+
+// The points of a sample split into the batches of check_convergence, where every point has a key such that
+// it lies in the body of a bisection round iff key <= x, e.g. its squared norm and the squared radius of a ball
+// centered at the origin. The keys are sorted once in every batch, so the ratio of a batch for a new x is a
+// binary search and a bisection round costs O(nu log(N/nu)) instead of N membership tests.
+template <typename NT>
+class SortedBatches {
+public:
+    SortedBatches(std::vector<NT> &keys, const int &nu) : m(keys.size() / nu) {
+        num_batches = keys.size() / m;
+        keys.resize(num_batches * m);
+        for (unsigned int j = 0; j < num_batches; ++j) std::sort(keys.begin() + j * m, keys.begin() + (j + 1) * m);
+        sorted.swap(keys);
+    }
+
+    unsigned int size() const {
+        return num_batches;
+    }
+
+    // the fraction of the points of the j-th batch with key <= x
+    NT ratio(const unsigned int j, const NT &x) const {
+        typename std::vector<NT>::const_iterator first = sorted.begin() + j * m;
+        return NT(std::upper_bound(first, first + m, x) - first) / NT(m);
+    }
+
+private:
+    unsigned int m, num_batches;
+    std::vector<NT> sorted;
+};
+
+
+// check_convergence for the body {key <= x} of a bisection round (see SortedBatches)
+template <typename NT>
+bool check_convergence(const SortedBatches<NT> &batches, const NT &x, const NT &lb, const NT &ub, bool &too_few,
+                       NT &ratio, const int &nu, const NT &alpha, const bool &precheck, const bool &lastball) {
+
+    std::vector<NT> ratios;
+    ratios.reserve(batches.size());
+    for (unsigned int j = 0; j < batches.size(); ++j) {
+        ratios.push_back(batches.ratio(j, x));
+        if (precheck && precheck_fails(ratios, lb, ub, too_few, ratio)) return false;
+    }
+    return test_batch_ratios(ratios, lb, ub, too_few, ratio, nu, alpha, precheck, lastball);
+}
+
+
+// The 1200 points that decide if the ball B(0, r) is the first ball are r*u for the same uniform points u of the
+// unit ball in every round. P contains the origin, so r*u lies in P iff r <= t(u), where t(u)*u is the boundary
+// point of P on the ray of u. Every u keeps the interval (lo, hi) of the radii that the previous rounds left
+// undecided, i.e. t(u) >= lo and t(u) < hi, so P.is_in() is called only for the points with r in the interval.
+// The bisection narrows the radii, so the later rounds test only the few points with t(u) close to them.
 template <typename RNGType, typename Polytope, typename ball, typename NT>
-bool get_first_ball(Polytope &P, ball &B0, NT &ratio, NT rad1, const NT &lb, const NT &ub, const NT &alpha, NT &rmax){
+bool get_first_ball(Polytope &P, ball &B0, NT &ratio, NT rad1, const NT &lb, const NT &ub, const NT &alpha, NT &rmax,
+                    RNGType &rng){
 
     typedef typename Polytope::PolytopePoint Point;
     int n = P.dimension(), iter = 1;
     bool bisection_int = false, pass = false, too_few = false;
-    std::list<Point> randPoints;
-    Point p(n);
+    PointStore<Point> unitPoints(n, 1200);
+    std::vector<NT> lo(1200, NT(0)), hi(1200, std::numeric_limits<NT>::max());
+    Point q(n);
+
+    for (int i = 0; i < 1200; ++i) unitPoints.push_back(get_point_in_Dsphere<RNGType, Point>(n, NT(1), rng));
+
+    // check_convergence for B(0, r)
+    auto check = [&](const NT &r) {
+        return check_convergence_batches(1200u, [&](const unsigned int j) -> bool {
+            if (r <= lo[j]) return true;
+            if (r >= hi[j]) return false;
+            unitPoints.get_point(j, q);
+            q *= r;
+            if (P.is_in(q) == -1) {
+                lo[j] = r;
+                return true;
+            }
+            hi[j] = r;
+            return false;
+        }, lb, ub, too_few, ratio, 10, alpha, true, false);
+    };
 
     if(rmax>0.0) {
-        for (int i = 0; i < 1200; ++i) {
-            randPoints.push_back(get_point_in_Dsphere<RNGType, Point>(n, rmax));
-        }
-        pass = check_convergence<Point>(P, randPoints, lb, ub, too_few, ratio, 10, alpha, true, false);
+        pass = check(rmax);
         if (pass || !too_few) {
             B0 = ball(Point(n), rmax*rmax);
             return true;
@@ -86,12 +183,9 @@ bool get_first_ball(Polytope &P, ball &B0, NT &ratio, NT rad1, const NT &lb, con
 
     while(!bisection_int) {
 
-        randPoints.clear();
         too_few = false;
 
-        for (int i = 0; i < 1200; ++i) randPoints.push_back(get_point_in_Dsphere<RNGType, Point>(n, rmax));
-
-        if(check_convergence<Point>(P, randPoints, lb, ub, too_few, ratio, 10, alpha, true, false)) {
+        if(check(rmax)) {
             B0 = ball(Point(n), rmax*rmax);
             return true;
         }
@@ -106,12 +200,9 @@ bool get_first_ball(Polytope &P, ball &B0, NT &ratio, NT rad1, const NT &lb, con
     while(iter <= MAX_ITER) {
 
         rad_med = 0.5*(rad1+rmax);
-        randPoints.clear();
         too_few = false;
 
-        for (int i = 0; i < 1200; ++i) randPoints.push_back(get_point_in_Dsphere<RNGType, Point>(n, rad_med));
-
-        if(check_convergence<Point>(P, randPoints, lb, ub, too_few, ratio, 10, alpha, true, false)) {
+        if(check(rad_med)) {
             B0 = ball(Point(n), rad_med*rad_med);
             return true;
         }
@@ -133,28 +224,33 @@ bool get_first_ball(Polytope &P, ball &B0, NT &ratio, NT rad1, const NT &lb, con
 }
 
 
+// The key of a point in the bisection over the radius of the next ball is its squared norm (see SortedBatches)
 template <typename Point, typename ball, typename PointList, typename NT>
 bool get_next_zonoball(std::vector<ball> &BallSet, PointList &randPoints, NT rad_min, std::vector<NT> &ratios,
                        const NT &lb, const NT &ub, NT &alpha, const int &nu){
 
-    int n = (*randPoints.begin()).dimension(), iter = 1;
+    int n = randPoints.dimension(), iter = 1;
     bool too_few;
-    NT radmax = 0.0, rad, pnorm, ratio;
+    NT radmax = randPoints.max_squared_norm(), rad, ratio;
+    Point q(n);
 
-    for (typename PointList::iterator rpit = randPoints.begin();  rpit!=randPoints.end(); ++rpit) {
-        pnorm = (*rpit).squared_length();
-        if (pnorm > radmax) radmax = pnorm;
+    std::vector<NT> keys(randPoints.size());
+    for (unsigned int j = 0; j < randPoints.size(); ++j) {
+        randPoints.get_point(j, q);
+        keys[j] = q.squared_length();
     }
+    SortedBatches<NT> batches(keys, nu);
+
     ball Biter;
     radmax=std::sqrt(radmax);
     NT rad0 = rad_min, rad_m = radmax;
 
     while (iter <= MAX_ITER) {
         rad = 0.5 * (rad_min + radmax);
-        Biter = ball(Point(n), rad * rad);
         too_few = false;
 
-        if (check_convergence<Point>(Biter, randPoints, lb, ub, too_few, ratio, nu, alpha, false, false)) {
+        if (check_convergence(batches, rad * rad, lb, ub, too_few, ratio, nu, alpha, false, false)) {
+            Biter = ball(Point(n), rad * rad);
             BallSet.push_back(Biter);
             ratios.push_back(ratio);
             return true;
@@ -186,17 +282,17 @@ bool get_sequence_of_polyballs(Polytope &P, std::vector<ball> &BallSet, std::vec
     bool fail;
     int n = P.dimension();
     NT ratio, ratio0;
-    std::list<Point> randPoints;
+    PointStore<Point> randPoints(n, Ntot);
     ball B0;
     Point q(n);
     PolyBall zb_it;
 
-    if( !get_first_ball<RNGType>(P, B0, ratio, radius, lb, ub, alpha, rmax) ) {
+    if( !get_first_ball<RNGType>(P, B0, ratio, radius, lb, ub, alpha, rmax, var.rng) ) {
         return false;
     }
 
     ratio0 = ratio;
-    rand_point_generator(P, q, Ntot, var.walk_steps, randPoints, var);
+    parallel_rand_point_generator(P, q, Ntot, var.walk_steps, randPoints, var);
 
     if (check_convergence<Point>(B0, randPoints, lb, ub, fail, ratio, nu, alpha, false, true)) {
         ratios.push_back(ratio);
@@ -213,7 +309,7 @@ bool get_sequence_of_polyballs(Polytope &P, std::vector<ball> &BallSet, std::vec
         q=Point(n);
         randPoints.clear();
         zb_it.comp_diam(var.diameter, 0.0);
-        rand_point_generator(zb_it, q, Ntot, var.walk_steps, randPoints,var);
+        parallel_rand_point_generator(zb_it, q, Ntot, var.walk_steps, randPoints, var);
 
         if (check_convergence<Point>(B0, randPoints, lb, ub, fail, ratio, nu, alpha, false, true)) {
             ratios.push_back(ratio);
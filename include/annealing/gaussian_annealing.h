@@ -23,6 +23,7 @@
 #define GAUSSIAN_ANNEALING_H
 
 #include <complex>
+#include "gaussian_samplers.h"
 
 template<typename T, typename U>
 struct is_same
@@ -123,7 +124,7 @@ void get_first_gaussian(Polytope & P,
 
 
 // Compute a_{i+1} when a_i is given
-template <typename Polytope, typename Parameters, typename Point, typename NT>
+template <typename WalkPolicy, typename Polytope, typename Parameters, typename Point, typename NT>
 NT get_next_gaussian(Polytope &P, Point &p, NT a, const unsigned int &N,
                      const NT &ratio, const NT &C, Parameters const& var){
 
@@ -133,19 +134,21 @@ NT get_next_gaussian(Polytope &P, Point &p, NT a, const unsigned int &N,
     const NT tol = 0.00001;
     bool done=false;
     std::vector<NT> fn(N,NT(0.0));
-    std::list<Point> randPoints;
+    PointStore<Point> randPoints(p.dimension(), N);
+    Point q(p.dimension());
     typedef typename std::vector<NT>::iterator viterator;
 
-    //sample N points using hit and run or ball walk
-    rand_gaussian_point_generator(P, p, N, var.walk_steps, randPoints, last_a, var);
+    //sample N points using hit and run or ball walk, with var.n_threads parallel chains
+    parallel_rand_gaussian_point_generator<WalkPolicy>(P, p, N, var.walk_steps, randPoints, last_a, var);
 
     viterator fnit;
     while(!done){
         a = last_a*std::pow(ratio,k);
 
         fnit = fn.begin();
-        for(typename std::list<Point>::iterator pit=randPoints.begin(); pit!=randPoints.end(); ++pit, fnit++){
-            *fnit = eval_exp(*pit,a)/eval_exp(*pit, last_a);
+        for(unsigned int j = 0; j < randPoints.size(); ++j, fnit++){
+            randPoints.get_point(j, q);
+            *fnit = eval_exp(q,a)/eval_exp(q, last_a);
         }
         std::pair<NT, NT> mv = getMeanVariance(fn);
 
@@ -164,12 +167,13 @@ NT get_next_gaussian(Polytope &P, Point &p, NT a, const unsigned int &N,
 }
 
 
-// Compute the sequence of spherical gaussians
-template <typename Polytope, typename Parameters, typename NT>
+// Compute the sequence of spherical gaussians using the random walk WalkPolicy
+template <typename WalkPolicy, typename Polytope, typename Parameters, typename NT>
 void get_annealing_schedule(Polytope &P, const NT &radius, const NT &ratio, const NT &C, const NT &frac,
         const unsigned int &N, Parameters &var, NT &error, std::vector<NT> &a_vals){
 
     typedef typename Polytope::PolytopePoint Point;
+    typedef typename WalkPolicy::template Walk<Polytope, Point, Parameters> Walk;
     // Compute the first gaussian
     get_first_gaussian(P, radius, frac, var, error, a_vals);
     #ifdef VOLESTI_DEBUG
@@ -179,9 +183,8 @@ void get_annealing_schedule(Polytope &P, const NT &radius, const NT &ratio, cons
 
     NT a_stop = 0.0, curr_fn = 2.0, curr_its = 1.0, next_a;
     const NT tol = 0.001;
-    unsigned int it = 0, n = var.n, steps, coord_prev;
+    unsigned int it = 0, n = var.n;
     const unsigned int totalSteps= ((int)150/error)+1;
-    std::list<Point> randPoints;
 
     if(a_vals[0]<a_stop) {
         a_vals[0] = a_stop;
@@ -193,32 +196,23 @@ void get_annealing_schedule(Polytope &P, const NT &radius, const NT &ratio, cons
     if(print) std::cout<<"Computing the sequence of gaussians..\n"<<std::endl;
     #endif
 
-    Point p_prev=p;
-
-    std::vector<NT> lamdas(P.num_of_hyperplanes(), NT(0));
     while (true) {
 
         if (var.ball_walk) {
             var.delta = 4.0 * var.che_rad / std::sqrt(std::max(NT(1.0), a_vals[it]) * NT(n));
         }
         // Compute the next gaussian
-        next_a = get_next_gaussian(P, p, a_vals[it], N, ratio, C, var);
-
-        curr_fn = 0;
-        curr_its = 0;
-        std::fill(lamdas.begin(), lamdas.end(), NT(0));
-        steps = totalSteps;
+        next_a = get_next_gaussian<WalkPolicy>(P, p, a_vals[it], N, ratio, C, var);
 
-        if (var.cdhr_walk){
-            gaussian_first_coord_point(P, p, p_prev, coord_prev, var.walk_steps, a_vals[it], lamdas, var);
-            curr_its += 1.0;
-            curr_fn += eval_exp(p, next_a) / eval_exp(p, a_vals[it]);
-            steps--;
-        }
+        // Compute some ratios to decide if this is the last gaussian.
+        // p has been moved by get_next_gaussian, so start a new chain from it
+        Walk walk(P, p, a_vals[it], var);
+        walk.apply(P, p, a_vals[it], var.walk_steps - 1, var);
+        curr_its = 1.0;
+        curr_fn = eval_exp(p, next_a) / eval_exp(p, a_vals[it]);
 
-        // Compute some ratios to decide if this is the last gaussian
-        for (unsigned  int j = 0; j < steps; j++) {
-            gaussian_next_point(P, p, p_prev, coord_prev, var.walk_steps, a_vals[it], lamdas, var);
+        for (unsigned  int j = 1; j < totalSteps; j++) {
+            walk.apply(P, p, a_vals[it], var.walk_steps, var);
             curr_its += 1.0;
             curr_fn += eval_exp(p, next_a) / eval_exp(p, a_vals[it]);
         }
@@ -7,40 +7,13 @@
 #define HPOLY_ANNEALING_H
 
 
-template <typename Hpolytope, typename ZonoHP, typename MT, typename VT, typename Parameters, typename NT>
-void comp_diam_hpoly_zono_inter(ZonoHP &ZHP, const MT &G, const MT &AG, const VT &b, const Parameters &var,
-        std::vector<NT> &diams_inter) {
+// the diameter of the intersection of a zonotope with an H-polytope, estimated from support queries
+template <typename ZonoHP, typename NT>
+void comp_diam_hpoly_zono_inter(ZonoHP &ZHP, std::vector<NT> &diams_inter) {
 
-    typedef typename Hpolytope::PolytopePoint Point;
-    //typedef typename ZonoHP::NT NT;
-
-    int k = G.cols(), d= ZHP.dimension();
-
-    MT eyes1(k, 2*k);
-    eyes1 << MT::Identity(k,k), -1.0*MT::Identity(k,k);
-
-    MT M1(k, 4*k);
-
-    M1 << AG.transpose(), eyes1;
-    MT M = M1.transpose();
-
-    VT bb(4*k);
-    for (int i = 0; i < 4*k; ++i) bb(i) = (i < 2*k) ? b(i) : 1.0;
-
-    Hpolytope HP;
-    HP.init(d, M, bb);
-
-    std::list<Point> randPoints;
-    std::pair<Point, NT> InnerBall = HP.ComputeInnerBall();
-    boundary_rand_point_generator(HP, InnerBall.first, 2*d*d, 1, randPoints, var);
-
-    typename std::list<Point>::iterator rpit=randPoints.begin();
-    NT max_norm = 0.0, iter_norm;
-    for ( ; rpit!=randPoints.end(); rpit++) {
-        iter_norm = (G*Eigen::Map<VT>(&(*rpit).get_coeffs()[0], (*rpit).dimension())).norm();
-        if (iter_norm > max_norm) max_norm = iter_norm;
-    }
-    diams_inter.push_back(2.0 * max_norm);
+    NT diam;
+    ZHP.comp_diam(diam, 0.0);
+    diams_inter.push_back(diam);
 
 }
 
@@ -59,7 +32,7 @@ bool get_first_poly(Polytope &P, HPolytope &HP, VT &Zs_max_gl, const NT &lb, con
     int n = P.dimension(), m = Zs_max_gl.size(), N = 1200, iter = 1, count = 0;
     Point q(n);
     bool too_few, print = false;
-    std::list<Point> randPoints;
+    PointStore<Point> randPoints(n, N);
 
     NT l=0.0, u=1.0, med;
     VT  Zmed(m);
@@ -72,7 +45,7 @@ bool get_first_poly(Polytope &P, HPolytope &HP, VT &Zs_max_gl, const NT &lb, con
         HPiter.set_vec(Zmed);
 
         randPoints.clear();
-        rand_point_generator(HPiter, q, 1200, 10+2*n, randPoints, var);
+        parallel_rand_point_generator(HPiter, q, N, 10+2*n, randPoints, var);
         too_few = false;
 
         if(check_convergence<Point>(P, randPoints, lb, up_lim, too_few, ratio, 10, 0.2, true, false)) {
@@ -99,25 +72,46 @@ bool get_first_poly(Polytope &P, HPolytope &HP, VT &Zs_max_gl, const NT &lb, con
 }
 
 
+// The bisection is over med in [0,1] for the H-polytopes {A x <= Zs_min + med*(Zs_max - Zs_min)}, where
+// Zs_max >= Zs_min, so they grow with med. A point x lies in the polytope of med iff med >= t(x), where t(x) is
+// the largest (a_i^T x - Zs_min_i) / (Zs_max_i - Zs_min_i) over the facets. A*x is computed once for all the
+// points with one matrix product and t(x) is the key of x (see SortedBatches), so a bisection round counts keys
+// instead of calling HP2.is_in() for every point.
 template <typename Zonotope, typename HPolytope, typename VT, typename PointList, typename NT>
 bool get_next_zonoball(Zonotope &Z, std::vector<HPolytope> &HPolySet,
                          HPolytope &HP2, const VT &Zs_max, const VT &Zs_min, PointList &randPoints,
                         std::vector<NT> &ratios, const NT &p_value, const NT &up_lim, const int &nu, const NT &alpha){
 
-    typedef typename Zonotope::PolytopePoint Point;
+    typedef typename Zonotope::MT MT;
 
-    int n = Z.dimension(), iter = 1;
+    int iter = 1, m = Zs_max.size();
     bool too_few;
-    VT Zmed(Zs_max.size());
-    NT ratio, med, u = 1.0, l = 0.0;
+    VT Zmed(m), Zs_diff = Zs_max - Zs_min;
+    NT ratio, med, u = 1.0, l = 0.0, slack, t;
+
+    const MT AX = HP2.get_mat() * randPoints.matrix();
+    std::vector<NT> keys(randPoints.size());
+    for (unsigned int j = 0; j < randPoints.size(); ++j) {
+        t = -std::numeric_limits<NT>::max();
+        for (int i = 0; i < m; ++i) {
+            slack = AX(i, j) - Zs_min(i);
+            if (Zs_diff(i) > NT(0)) {
+                t = std::max(t, slack / Zs_diff(i));
+            } else if (slack > NT(0)) {
+                t = std::numeric_limits<NT>::max();
+            }
+        }
+        keys[j] = t;
+    }
+    SortedBatches<NT> batches(keys, nu);
 
     while (iter <= MAX_ITER) {
         med = (u + l) * 0.5;
-        Zmed = Zs_min + (Zs_max-Zs_min)*med;
-        HP2.set_vec(Zmed);
         too_few = false;
 
-        if(check_convergence<Point>(HP2, randPoints, p_value, up_lim, too_few, ratio, nu, alpha, false, false)){
+        if(check_convergence(batches, med, p_value, up_lim, too_few, ratio, nu, alpha, false, false)){
+            Zmed = Zs_min + Zs_diff*med;
+            HP2.set_vec(Zmed);
             HPolySet.push_back(HP2);
             ratios.push_back(ratio);
             return true;
@@ -139,7 +133,7 @@ bool get_next_zonoball(Zonotope &Z, std::vector<HPolytope> &HPolySet,
 template <typename ZonoHP, typename Zonotope, typename HPolytope, typename VT, typename Parameters, typename NT>
 bool get_sequence_of_zonopolys(Zonotope &Z, const HPolytope &HP, std::vector<HPolytope> &HPolySet,
                                const VT &Zs_max, std::vector<NT> &ratios, const int &Ntot, const int &nu,
-                               const NT &p_value, const NT &up_lim, const NT &alpha, Parameters &var, const Parameters &var2,
+                               const NT &p_value, const NT &up_lim, const NT &alpha, Parameters &var,
                                std::vector<NT> &diams_inter) {
 
     bool print = var.verbose, too_few=false;
@@ -147,13 +141,11 @@ bool get_sequence_of_zonopolys(Zonotope &Z, const HPolytope &HP, std::vector<HPo
     typedef typename Zonotope::MT MT;
 
     int n = var.n;
-    MT G = Z.get_mat().transpose();
-    MT AG = HP.get_mat()*G;
     NT ratio;
-    std::list<Point> randPoints;
+    PointStore<Point> randPoints(n, Ntot);
     Point q(n);
 
-    rand_point_generator(Z, q, Ntot, var.walk_steps, randPoints, var);
+    parallel_rand_point_generator(Z, q, Ntot, var.walk_steps, randPoints, var);
     HPolytope HP2 = HP;
     if (check_convergence<Point>(HP, randPoints, p_value, up_lim, too_few, ratio, nu, alpha, false, true)) {
         ratios.push_back(ratio);
@@ -171,9 +163,9 @@ bool get_sequence_of_zonopolys(Zonotope &Z, const HPolytope &HP, std::vector<HPo
         ZHP2 = ZonoHP(Z,HP2);
         q=Point(n);
         randPoints.clear();
-        comp_diam_hpoly_zono_inter<HPolytope>(ZHP2, G, AG, HP2.get_vec(), var2, diams_inter);
+        comp_diam_hpoly_zono_inter(ZHP2, diams_inter);
         var.diameter = diams_inter[diams_inter.size()-1];
-        rand_point_generator(ZHP2, q, Ntot, var.walk_steps, randPoints, var);
+        parallel_rand_point_generator(ZHP2, q, Ntot, var.walk_steps, randPoints, var);
         if (check_convergence<Point>(HP, randPoints, p_value, up_lim, too_few, ratio, nu, alpha, false, true)) {
             ratios.push_back(ratio);
             return true;
@@ -20,34 +20,27 @@ bool check_max_error(const NT &a, const NT &b, const NT &error) {
 }
 
 
-template <typename RNGType, typename Point, typename PolyBall1, typename PolyBall2, typename NT, typename Parameters>
+// Estimate the ratio vol(Pb2 \cap Pb1)/vol(Pb1) with points sampled from Pb1 with the random walk WalkPolicy.
+// Stop when the values of the ratio in the last W steps lie in an interval of relative length error/2.
+template <typename WalkPolicy, typename Point, typename PolyBall1, typename PolyBall2, typename NT, typename Parameters>
 NT esti_ratio(PolyBall1 &Pb1, PolyBall2 &Pb2, const NT &ratio, const NT &error, const int &W,
-        const int &Ntot, const Parameters &var, bool isball = false, NT radius = 0.0) {
+        const int &Ntot, const Parameters &var) {
 
     int n = var.n, min_index = W-1, max_index = W-1, index = 0, iter = 1;
     bool print = var.verbose;
-    NT min_val = std::numeric_limits<NT>::lowest(), max_val = std::numeric_limits<NT>::max(), val, lambda;
+    NT min_val = std::numeric_limits<NT>::lowest(), max_val = std::numeric_limits<NT>::max(), val;
     size_t totCount = Ntot, countIn = Ntot * ratio;
-    std::vector<NT> last_W(W), lamdas(Pb1.num_of_hyperplanes()), Av(Pb1.num_of_hyperplanes());
-    std::list<Point> randPoints;
+    std::vector<NT> last_W(W);
     typename std::vector<NT>::iterator minmaxIt;
-    typename std::list<Point>::iterator rpit;
     Point p(n);
-    Point p_prev=p;
-    unsigned int coord_prev;
 
-    if(!var.ball_walk && !isball){
-        uniform_first_point(Pb1,p,p_prev,coord_prev,var.walk_steps,lamdas,Av,lambda,var);
-    }
+    typename WalkPolicy::template Walk<PolyBall1, Point, Parameters> walk(Pb1, p, var);
+    walk.apply(Pb1, p, var.walk_steps - 1, var);
 
     while(iter <= MAX_ITER_ESTI){
         iter++;
 
-        if (isball) {
-            p = get_point_in_Dsphere<RNGType, Point>(n, radius);
-        } else {
-            uniform_next_point(Pb1, p, p_prev, coord_prev, var.walk_steps, lamdas, Av, lambda, var);
-        }
+        walk.apply(Pb1, p, var.walk_steps, var);
         if(Pb2.is_in(p)==-1) countIn = countIn + 1.0;
 
         totCount = totCount + 1.0;
@@ -84,29 +77,26 @@ NT esti_ratio(PolyBall1 &Pb1, PolyBall2 &Pb2, const NT &ratio, const NT &error,
 }
 
 
-template <typename RNGType, typename Point, typename PolyBall1, typename PolyBall2, typename NT, typename Parameters>
+// Estimate the ratio vol(Pb2 \cap Pb1)/vol(Pb1) with points sampled from Pb1 with the random walk WalkPolicy.
+// Stop when the confidence interval of the ratio with probability prob, computed from the last W values,
+// has relative length at most error/2.
+template <typename WalkPolicy, typename Point, typename PolyBall1, typename PolyBall2, typename NT, typename Parameters>
 NT esti_ratio_interval(PolyBall1 &Pb1, PolyBall2 &Pb2, const NT &ratio, const NT &error, const int &W,
-        const int &Ntot, const NT &prob, const Parameters &var, bool isball = false, NT radius = 0.0) {
+        const int &Ntot, const NT &prob, const Parameters &var) {
 
     int n = var.n, index = 0, iter = 1;
     bool print = var.verbose;
-    std::vector<NT> last_W(W), lamdas(Pb1.num_of_hyperplanes()), Av(Pb1.num_of_hyperplanes());
-    NT val, sum_sq=0.0, sum=0.0, lambda;
+    std::vector<NT> last_W(W);
+    NT val, sum_sq=0.0, sum=0.0;
     size_t totCount = Ntot, countIn = Ntot * ratio;
     //std::cout<<"countIn = "<<countIn<<", totCount = "<<totCount<<std::endl;
 
     Point p(n);
-    Point p_prev=p;
-    unsigned int coord_prev;
-    if(!var.ball_walk && !isball) uniform_first_point(Pb1, p, p_prev, coord_prev, 1,
-                                                                             lamdas, Av, lambda, var);
+    typename WalkPolicy::template Walk<PolyBall1, Point, Parameters> walk(Pb1, p, var);
+
     for (int i = 0; i < W; ++i) {
 
-        if (isball) {
-            p = get_point_in_Dsphere<RNGType, Point>(n, radius);
-        } else {
-            uniform_next_point(Pb1, p, p_prev, coord_prev, var.walk_steps, lamdas, Av, lambda, var);
-        }
+        walk.apply(Pb1, p, var.walk_steps, var);
         if (Pb2.is_in(p) == -1) countIn = countIn + 1;
 
         totCount = totCount + 1;
@@ -125,11 +115,7 @@ NT esti_ratio_interval(PolyBall1 &Pb1, PolyBall2 &Pb2, const NT &ratio, const NT
     while(iter <= MAX_ITER_ESTI) {
         iter++;
 
-        if (isball) {
-            p = get_point_in_Dsphere<RNGType, Point>(n, radius);
-        } else {
-            uniform_next_point(Pb1, p, p_prev, coord_prev, var.walk_steps, lamdas, Av, lambda, var);
-        }
+        walk.apply(Pb1, p, var.walk_steps, var);
         if (Pb2.is_in(p) == -1) countIn = countIn + 1;
 
         totCount = totCount + 1;
@@ -153,5 +139,28 @@ NT esti_ratio_interval(PolyBall1 &Pb1, PolyBall2 &Pb2, const NT &ratio, const NT
 
 }
 
+// The following two estimators select the random walk from the flags of var
+// and call the corresponding specialization above.
+template <typename Point, typename PolyBall1, typename PolyBall2, typename NT, typename Parameters>
+NT esti_ratio(PolyBall1 &Pb1, PolyBall2 &Pb2, const NT &ratio, const NT &error, const int &W,
+        const int &Ntot, const Parameters &var) {
+
+    if (var.ball_walk) return esti_ratio<BallWalk, Point>(Pb1, Pb2, ratio, error, W, Ntot, var);
+    if (var.cdhr_walk) return esti_ratio<CDHRWalk, Point>(Pb1, Pb2, ratio, error, W, Ntot, var);
+    if (var.rdhr_walk) return esti_ratio<RDHRWalk, Point>(Pb1, Pb2, ratio, error, W, Ntot, var);
+    return esti_ratio<BilliardWalk, Point>(Pb1, Pb2, ratio, error, W, Ntot, var);
+}
+
+
+template <typename Point, typename PolyBall1, typename PolyBall2, typename NT, typename Parameters>
+NT esti_ratio_interval(PolyBall1 &Pb1, PolyBall2 &Pb2, const NT &ratio, const NT &error, const int &W,
+        const int &Ntot, const NT &prob, const Parameters &var) {
+
+    if (var.ball_walk) return esti_ratio_interval<BallWalk, Point>(Pb1, Pb2, ratio, error, W, Ntot, prob, var);
+    if (var.cdhr_walk) return esti_ratio_interval<CDHRWalk, Point>(Pb1, Pb2, ratio, error, W, Ntot, prob, var);
+    if (var.rdhr_walk) return esti_ratio_interval<RDHRWalk, Point>(Pb1, Pb2, ratio, error, W, Ntot, prob, var);
+    return esti_ratio_interval<BilliardWalk, Point>(Pb1, Pb2, ratio, error, W, Ntot, prob, var);
+}
+
 #endif
 
@@ -24,14 +24,17 @@
 
 #include "point.h"
 
-template <typename K>
+// D is the dimension of the space if it is known at compile time, e.g. Cartesian<double, 3>.
+// Then the points keep their coordinates on the stack and the Eigen kernels are fixed-size.
+template <typename K, int D = Eigen::Dynamic>
 class Cartesian
 {
 public:
-  typedef Cartesian<K> Self;
+  typedef Cartesian<K, D> Self;
   typedef K                    FT;
+  static const int fixed_dim = D;
   typedef point<Self>              Point;
-    
+
 };
 
 #endif
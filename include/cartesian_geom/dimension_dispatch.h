@@ -0,0 +1,37 @@
+// VolEsti (volume computation and sampling library)
+
+// Copyright (c) 20012-2019 Vissarion Fisikopoulos
+// Copyright (c) 2018-2019 Apostolos Chalkis
+
+// Licensed under GNU LGPL.3, see LICENCE file
+
+#ifndef DIMENSION_DISPATCH_H
+#define DIMENSION_DISPATCH_H
+
+
+// Runtime selection of a compile-time dimension.
+// dimension_dispatch<Dims...>::run(d, f) returns f.template apply<D>() if d == D for one of Dims
+// and f.template apply<Eigen::Dynamic>() otherwise. F has to define result_type.
+// Only the dimensions in Dims are instantiated, e.g. dimension_dispatch<2, 3, 4>.
+template <int... Dims>
+struct dimension_dispatch;
+
+template <>
+struct dimension_dispatch<> {
+    template <typename F>
+    static typename F::result_type run(const unsigned int d, F &f) {
+        return f.template apply<Eigen::Dynamic>();
+    }
+};
+
+template <int D, int... Dims>
+struct dimension_dispatch<D, Dims...> {
+    template <typename F>
+    static typename F::result_type run(const unsigned int d, F &f) {
+        if (d == D) return f.template apply<D>();
+        return dimension_dispatch<Dims...>::run(d, f);
+    }
+};
+
+
+#endif
@@ -10,33 +10,83 @@
 #define POINT_H
 
 #include <iostream>
+#include <vector>
+#include <array>
+#include <algorithm>
+
+
+// Storage of the coordinates of a point: a std::vector when the dimension is known at run time
+// and a std::array on the stack when it is fixed at compile time
+template <typename FT, int D>
+struct point_storage {
+    typedef std::array<FT, D> type;
+
+    static void resize(type &coeffs, const unsigned int dim) {}
+
+    template <typename InputIt>
+    static void assign(type &coeffs, InputIt begin, InputIt endit) {
+        std::copy(begin, endit, coeffs.begin());
+    }
+};
+
+template <typename FT>
+struct point_storage<FT, Eigen::Dynamic> {
+    typedef std::vector<FT> type;
+
+    static void resize(type &coeffs, const unsigned int dim) {
+        coeffs.resize(dim);
+    }
+
+    template <typename InputIt>
+    static void assign(type &coeffs, InputIt begin, InputIt endit) {
+        coeffs.assign(begin, endit);
+    }
+};
+
 
 template <typename K>
 class point
 {
+public:
+    typedef typename K::FT 	FT;
+    // the dimension if it is fixed at compile time, Eigen::Dynamic otherwise
+    enum { fixed_dim = K::fixed_dim };
+    typedef Eigen::Matrix<FT, fixed_dim, 1> VT;
+
 private:
+    typedef point_storage<FT, fixed_dim> Storage;
     unsigned int d;
-    typedef std::vector<typename K::FT> Coeff;
+    typedef typename Storage::type Coeff;
     Coeff coeffs;
-    typedef typename std::vector<typename K::FT>::iterator iter;
+    typedef typename Coeff::iterator iter;
+
 public:
-    typedef typename K::FT 	FT;
+    typedef iter iterator;
 
-    point() {}
+    point() : d(fixed_dim == Eigen::Dynamic ? 0 : int(fixed_dim)) {}
     
     point(const unsigned int &dim) {
         d = dim;
-        coeffs = Coeff(d,0);
+        Storage::resize(coeffs, d);
+        std::fill(coeffs.begin(), coeffs.end(), FT(0));
     }
-    
-    point(const unsigned int &dim, iter begin, iter endit) {
+
+    template <typename InputIt>
+    point(const unsigned int &dim, InputIt begin, InputIt endit) {
         d = dim;
-        coeffs = Coeff(begin,endit);
+        Storage::assign(coeffs, begin, endit);
     }
 
-    point(const unsigned int dim, Coeff cofs) {
+    point(const unsigned int dim, const std::vector<FT> &cofs) {
         d = dim;
-        coeffs.assign(cofs.begin(), cofs.end());
+        Storage::assign(coeffs, cofs.begin(), cofs.end());
+    }
+
+    template <typename Derived>
+    point(const Eigen::MatrixBase<Derived> &vec) {
+        d = vec.size();
+        Storage::resize(coeffs, d);
+        map() = vec;
     }
     
     int dimension() const {
@@ -51,48 +101,60 @@ public:
         coeffs[i] = coord;
     }
 
-    Coeff get_coeffs() {
+    const Coeff& get_coeffs() const {
         return coeffs;
     }
+
+    // the coordinates seen as an Eigen vector, without copying them
+    Eigen::Map<VT> map() {
+        return Eigen::Map<VT>(coeffs.data(), d);
+    }
+
+    Eigen::Map<const VT> map() const {
+        return Eigen::Map<const VT>(coeffs.data(), d);
+    }
     
     FT operator[] (const unsigned int &i) const {
         return coeffs[i];
     }
-    
-    point operator+ (point& p) {
-        point temp(p.dimension());
 
-        typename Coeff::iterator tmit = temp.iter_begin();
-        typename Coeff::iterator pit = p.iter_begin();
-        typename Coeff::iterator mit = coeffs.begin();
+    // in-place updates, they do not allocate
+    point& operator+= (const point& p) {
+        map() += p.map();
+        return *this;
+    }
 
-        for (; pit < p.iter_end(); ++pit, ++mit, ++tmit) {
-            (*tmit) = (*pit) + (*mit);
-        }
-        return temp;
+    point& operator-= (const point& p) {
+        map() -= p.map();
+        return *this;
     }
-    
-    point operator- (point& p) {
-        point temp(p.dimension());
 
-        typename Coeff::iterator tmit = temp.iter_begin();
-        typename Coeff::iterator pit = p.iter_begin();
-        typename Coeff::iterator mit = coeffs.begin();
+    point& operator*= (const FT& k) {
+        map() *= k;
+        return *this;
+    }
 
-        for (; pit < p.iter_end(); ++pit, ++mit, ++tmit) {
-            (*tmit) = (*mit) - (*pit);
-        }
+    // this = this + k * p, e.g. the step p = p + lambda * v of a random walk
+    point& axpy(const FT& k, const point& p) {
+        map() += k * p.map();
+        return *this;
+    }
+    
+    point operator+ (const point& p) const {
+        point temp(*this);
+        temp += p;
+        return temp;
+    }
+    
+    point operator- (const point& p) const {
+        point temp(*this);
+        temp -= p;
         return temp;
     }
 
-    point operator* (const FT& k) {
-        point temp(d, iter_begin(), iter_end());
-
-        typename Coeff::iterator tmit = temp.iter_begin();
-
-        for (; tmit < temp.iter_end(); ++tmit) {
-            (*tmit) *= k;
-        }
+    point operator* (const FT& k) const {
+        point temp(*this);
+        temp *= k;
         return temp;
     }
 
@@ -116,27 +178,13 @@ public:
     }
 
 
-    FT dot(point& p){
-        FT res=FT(0.0);
-
-        typename Coeff::iterator pit=p.iter_begin();
-        typename Coeff::iterator mit=coeffs.begin();
-        for( ; pit<p.iter_end(); ++pit, ++mit){
-            res+=(*mit)*(*pit);
-        }
-        return res;
+    FT dot(const point& p) const {
+        return map().dot(p.map());
     }
     
     
-    FT squared_length() {
-
-        FT lsq = FT(0.0);
-
-        typename Coeff::iterator mit=coeffs.begin();
-        for ( ; mit != coeffs.end(); mit++){
-            lsq += (*mit)*(*mit);
-        }
-        return lsq;
+    FT squared_length() const {
+        return map().squaredNorm();
     }
 
     void print(){
@@ -158,12 +206,21 @@ public:
     iter iter_end() {
         return coeffs.end();
     }
-    
+
+    // pointer to the contiguous coordinates, e.g. to map the point to an Eigen vector
+    FT* data() {
+        return coeffs.data();
+    }
+
+    const FT* data() const {
+        return coeffs.data();
+    }
+
     
 };
 
 template<typename K>
-point<K> operator* (typename K::FT const& k, point<K>& p) {
+point<K> operator* (typename K::FT const& k, point<K> const& p) {
     return p * k;
 }
 
@@ -14,7 +14,6 @@ struct Ball{
 public:
     typedef Point BallPoint;
     typedef typename Point::FT NT;
-    typedef typename std::vector<NT>::iterator viterator;
 
     Ball() {}
 
@@ -36,7 +35,14 @@ public:
         return c.dimension();
     }
 
-    int is_in(Point &p) {
+    // the support function h(u) = c^T u + radius * |u| and the point c + radius * u / |u| that attains it
+    std::pair<Point,NT> support(const Point &u) const {
+        NT norm = std::sqrt(u.squared_length());
+        Point x = c + (radius() / norm) * u;
+        return std::pair<Point,NT>(x, c.dot(u) + radius() * norm);
+    }
+
+    int is_in(const Point &p) const {
         if (p.squared_length() <= R)
             return -1;
         else return 0;
@@ -44,13 +50,7 @@ public:
 
     std::pair<NT,NT> line_intersect(Point &r, Point &v) {
 
-        viterator vit=v.iter_begin(), cit=c.iter_begin(), rcit=r.iter_begin();
-        NT vrc(0), v2(0), rc2(0);
-        for( ; cit < c.iter_end() ; ++cit, ++rcit, ++vit){
-            vrc += *vit * (*rcit);
-            v2 += *vit * (*vit);
-            rc2 += *rcit * (*rcit);
-        }
+        NT vrc = v.dot(r), v2 = v.squared_length(), rc2 = r.squared_length();
 
         NT disc_sqrt = std::sqrt(std::pow(vrc,2) - v2 * (rc2 - R));
         return std::pair<NT,NT> ((NT(-1)*vrc + disc_sqrt)/v2, (NT(-1)*vrc - disc_sqrt)/v2);
@@ -67,6 +67,22 @@ public:
         return line_intersect(r, v);
     }
 
+    // block version for K chains: the k-th columns of Rs and Vs are the point and the direction of the k-th chain
+    void line_intersect(const Eigen::Matrix<NT,Eigen::Dynamic,Eigen::Dynamic> &Rs,
+                        const Eigen::Matrix<NT,Eigen::Dynamic,Eigen::Dynamic> &Vs,
+                        Eigen::Matrix<NT,Eigen::Dynamic,1> &min_plus, Eigen::Matrix<NT,Eigen::Dynamic,1> &max_minus) {
+
+        typedef Eigen::Matrix<NT,Eigen::Dynamic,1> VT;
+
+        VT vrc = (Vs.cwiseProduct(Rs)).colwise().sum().transpose();
+        VT v2 = Vs.colwise().squaredNorm().transpose();
+        VT rc2 = Rs.colwise().squaredNorm().transpose();
+
+        VT disc_sqrt = (vrc.cwiseProduct(vrc) - v2.cwiseProduct(rc2 - VT::Constant(rc2.rows(), R))).cwiseSqrt();
+        min_plus = (disc_sqrt - vrc).cwiseQuotient(v2);
+        max_minus = (-disc_sqrt - vrc).cwiseQuotient(v2);
+    }
+
     std::pair<NT,int> line_positive_intersect(Point &r, Point &v){
         return std::pair<NT,NT>(line_intersect(r, v).first, 0);
     }
@@ -83,12 +99,8 @@ public:
 
     std::pair<NT,NT> line_intersect_coord(Point &r, const unsigned int &rand_coord) {
 
-        viterator rcit=r.iter_begin();
-        NT vrc = *(rcit + rand_coord);
-        NT rc2(R);
-        for( ; rcit < r.iter_end() ; ++rcit){
-            rc2 -= *rcit * (*rcit);
-        }
+        NT vrc = r[rand_coord];
+        NT rc2 = R - r.squared_length();
 
         NT disc_sqrt = std::sqrt(std::pow(vrc,2) + rc2);
         return std::pair<NT,NT> (NT(-1)*vrc + disc_sqrt, NT(-1)*vrc - disc_sqrt);
@@ -114,10 +126,8 @@ public:
 
     void compute_reflection (Point &v, const Point &p, const int &facet) {
 
-        Point s = p;
-        s = s * (1.0 / std::sqrt(s.squared_length()));
-        s = ((-2.0 * v.dot(s)) * s);
-        v = s + v;
+        // reflect v on the tangent hyperplane at p, whose normal is p/|p|
+        v.axpy((-2.0 * v.dot(p)) / p.squared_length(), p);
 
     }
 
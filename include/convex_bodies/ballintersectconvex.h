@@ -19,13 +19,15 @@ private:
 public:
     typedef typename CBall::NT NT;
     typedef typename CBall::BallPoint Point;
+    typedef typename Polytope::MT MT;
+    typedef typename Polytope::VT VT;
 
     BallIntersectPolytope() {}
 
     BallIntersectPolytope(Polytope &PP, CBall &BB) : P(PP), B(BB) {};
     
-    Polytope first() const { return P; }
-    CBall second() const { return B; }
+    const Polytope& first() const { return P; }
+    const CBall& second() const { return B; }
 
     int is_in(Point &p){
         if(B.is_in(p)==-1)
@@ -69,6 +71,26 @@ public:
                                  std::max(polypair.second, ballpair.second));
     }
 
+    // block ray shooting for K chains, see HPolytope
+    void line_intersect(const MT &R, const MT &V, MT &AR, MT &AV, VT &min_plus, VT &max_minus) {
+
+        VT ball_plus, ball_minus;
+        P.line_intersect(R, V, AR, AV, min_plus, max_minus);
+        B.line_intersect(R, V, ball_plus, ball_minus);
+        min_plus = min_plus.cwiseMin(ball_plus);
+        max_minus = max_minus.cwiseMax(ball_minus);
+    }
+
+    void line_intersect(const MT &R, const MT &V, MT &AR, MT &AV, const VT &lambdas_prev,
+                        VT &min_plus, VT &max_minus) {
+
+        VT ball_plus, ball_minus;
+        P.line_intersect(R, V, AR, AV, lambdas_prev, min_plus, max_minus);
+        B.line_intersect(R, V, ball_plus, ball_minus);
+        min_plus = min_plus.cwiseMin(ball_plus);
+        max_minus = max_minus.cwiseMax(ball_minus);
+    }
+
     std::pair<NT,int> line_positive_intersect(Point &r, Point &v, std::vector<NT> &Ar, std::vector<NT> &Av) {
 
         std::pair <NT, int> polypair = P.line_positive_intersect(r, v, Ar, Av);
@@ -0,0 +1,69 @@
+// VolEsti (volume computation and sampling library)
+
+// Copyright (c) 20012-2019 Vissarion Fisikopoulos
+// Copyright (c) 2018-2019 Apostolos Chalkis
+
+// Licensed under GNU LGPL.3, see LICENCE file
+
+#ifndef DIAMETER_H
+#define DIAMETER_H
+
+#include <cmath>
+#include <utility>
+
+// Estimate the diameter of a convex body P from its support function h(u) = max {u^T x : x in P}.
+// The bodies provide support(u), which returns a maximizer s(u) and h(u).
+// The chord s(u) - s(-u) is a segment in P, so its length is a lower bound on the diameter, and it is
+// at least the width h(u) + h(-u) of P along u. The widths along the d coordinate axes bound the
+// diameter from above by the diagonal of the bounding box, i.e. by sqrt(d) times the largest of them.
+// The direction of the longest chord is refined by u <- s(u) - s(-u), which never shortens the chord
+// (the width along the new u is at least the length of the old chord), until it grows by less than 1%.
+// Every direction is perturbed by a small fixed vector w, so that ties (e.g. the facets of a cube
+// orthogonal to an axis) do not make s(u) - s(-u) a chord orthogonal to the facets.
+// After rounding the coordinate axes are the axes of the rounding ellipsoid.
+// The cost is 2d + 2*max_iter support queries.
+template <typename Point, typename ConvexBody, typename NT>
+void approx_diameter(ConvexBody &P, NT &diam, const unsigned int max_iter = 10) {
+
+    const unsigned int d = P.dimension();
+    Point u(d), best(d), w(d);
+    diam = NT(0);
+
+    // the fractional parts of multiples of the golden ratio, shifted to [-1/2, 1/2)
+    const NT eps = NT(1e-3);
+    for (unsigned int j = 0; j < d; ++j) {
+        NT f = NT(j + 1) * NT(0.6180339887498949);
+        w.set_coord(j, eps * (f - std::floor(f) - NT(0.5)));
+    }
+
+    // the length of the chord s(u) - s(-u), or -1 if a support query failed
+    auto chord = [&](Point &c) -> NT {
+        std::pair<Point,NT> s1 = P.support(u), s2 = P.support(NT(-1) * u);
+        if (!std::isfinite(s1.second + s2.second)) return NT(-1);
+        c = s1.first - s2.first;
+        return std::sqrt(c.squared_length());
+    };
+
+    Point c(d);
+    for (unsigned int i = 0; i < d; ++i) {
+        u = w;
+        u.set_coord(i, NT(1) + w[i]);
+        NT len = chord(c);
+        if (len > diam) {
+            diam = len;
+            best = c;
+        }
+    }
+
+    for (unsigned int it = 0; it < max_iter && diam > NT(0); ++it) {
+        u = (NT(1) / diam) * best + w;
+        NT len = chord(c);
+        if (len <= diam) break;
+        bool converged = len < NT(1.01) * diam;
+        diam = len;
+        best = c;
+        if (converged) break;
+    }
+}
+
+#endif
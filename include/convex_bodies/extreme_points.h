@@ -0,0 +1,210 @@
+// VolEsti (volume computation and sampling library)
+
+// Copyright (c) 20012-2019 Vissarion Fisikopoulos
+// Copyright (c) 2018-2019 Apostolos Chalkis
+
+// Licensed under GNU LGPL.3, see LICENCE file
+
+#ifndef EXTREME_POINTS_H
+#define EXTREME_POINTS_H
+
+#include <vector>
+#include <algorithm>
+#include <thread>
+#include "vpolyoracles.h"
+
+// The extreme points of a finite point set, i.e. the vertices of its convex hull.
+// 1. Duplicate points are merged.
+// 2. The points whose projection on a coordinate plane (x_j, x_{j+1}) is a vertex of the convex hull
+//    of the projections, and no other point has the same projection, are vertices. O(k log k) per plane.
+// 3. The other points are tested by Clarkson's algorithm: a point p is redundant iff it lies in the
+//    convex hull of the known vertices E, which is decided by an LP with |E| columns. Otherwise the dual
+//    of the LP gives a direction a with a^T p > a^T e for every e in E, and the point that maximizes a^T x
+//    is a vertex out of E. It is added to E, until it is p itself or p is found redundant. So the LPs have
+//    as many columns as vertices, not as points. The points are split among n_threads threads, each with
+//    its own E.
+
+
+// mark the points of the 2D point set (x(i), y(i)) that are vertices of its convex hull and
+// are the only point at their position (Andrew's monotone chain)
+template <typename VT>
+void mark_hull_vertices_2d(const VT &x, const VT &y, std::vector<char> &vertex) {
+
+    typedef typename VT::Scalar NT;
+    const int k = x.rows();
+    std::vector<int> order(k);
+    for (int i = 0; i < k; ++i) order[i] = i;
+    std::sort(order.begin(), order.end(), [&](const int i, const int j) {
+        return x(i) < x(j) || (x(i) == x(j) && y(i) < y(j));
+    });
+
+    // merge the points with the same projection
+    std::vector<int> pts;
+    std::vector<char> unique;
+    for (int s = 0; s < k; ++s) {
+        int i = order[s];
+        if (!pts.empty() && x(pts.back()) == x(i) && y(pts.back()) == y(i)) {
+            unique.back() = 0;
+        } else {
+            pts.push_back(i);
+            unique.push_back(1);
+        }
+    }
+    const int n = pts.size();
+    if (n < 3) {
+        for (int s = 0; s < n; ++s) {
+            if (unique[s]) vertex[pts[s]] = 1;
+        }
+        return;
+    }
+
+    // the cross product of (o,a) and (o,b); only strict left turns are kept, so the points in the
+    // relative interior of an edge are dropped
+    auto cross = [&](const int o, const int a, const int b) {
+        return (x(pts[a]) - x(pts[o])) * (y(pts[b]) - y(pts[o])) - (y(pts[a]) - y(pts[o])) * (x(pts[b]) - x(pts[o]));
+    };
+    std::vector<int> hull(2 * n);
+    int h = 0;
+    for (int s = 0; s < n; ++s) {
+        while (h >= 2 && cross(hull[h - 2], hull[h - 1], s) <= NT(0)) h--;
+        hull[h++] = s;
+    }
+    for (int s = n - 2, t = h + 1; s >= 0; --s) {
+        while (h >= t && cross(hull[h - 2], hull[h - 1], s) <= NT(0)) h--;
+        hull[h++] = s;
+    }
+    for (int s = 0; s < h - 1; ++s) {
+        if (unique[hull[s]]) vertex[pts[hull[s]]] = 1;
+    }
+}
+
+
+// true if the row i of U is lexicographically smaller than the row j
+template <typename MT>
+bool lex_less(const MT &U, const int i, const int j) {
+    for (int l = 0; l < U.cols(); ++l) {
+        if (U(i, l) != U(j, l)) return U(i, l) < U(j, l);
+    }
+    return false;
+}
+
+
+// return the indices of the rows of V that are the vertices of their convex hull, in increasing order.
+// Of equal rows only the first one is returned
+template <typename MT>
+std::vector<int> extreme_points(const MT &V, const unsigned int n_threads = 1) {
+
+    typedef typename MT::Scalar NT;
+    typedef Eigen::Matrix<NT, Eigen::Dynamic, 1> VT;
+    const int k = V.rows(), d = V.cols();
+
+    // merge the duplicates
+    std::vector<int> order(k);
+    for (int i = 0; i < k; ++i) order[i] = i;
+    std::sort(order.begin(), order.end(), [&](const int i, const int j) {
+        return lex_less(V, i, j) || (!lex_less(V, j, i) && i < j);
+    });
+    std::vector<int> rows;
+    for (int s = 0; s < k; ++s) {
+        if (s == 0 || V.row(order[s]) != V.row(order[s - 1])) rows.push_back(order[s]);
+    }
+    std::sort(rows.begin(), rows.end());
+    const int n = rows.size();
+    MT U(n, d);
+    for (int i = 0; i < n; ++i) U.row(i) = V.row(rows[i]);
+
+    // the vertices certified by the projections
+    std::vector<char> vertex(n, 0);
+    if (d == 1) {
+        int imin, imax;
+        U.col(0).minCoeff(&imin);
+        U.col(0).maxCoeff(&imax);
+        vertex[imin] = vertex[imax] = 1;
+    } else {
+        for (int j = 0; j < d; ++j) {
+            if (d == 2 && j == 1) break;
+            mark_hull_vertices_2d(VT(U.col(j)), VT(U.col((j + 1) % d)), vertex);
+        }
+    }
+
+    // the lexicographically largest point is a vertex
+    int top = 0;
+    for (int i = 1; i < n; ++i) {
+        if (lex_less(U, top, i)) top = i;
+    }
+    vertex[top] = 1;
+
+    std::vector<int> candidates;
+    for (int i = 0; i < n; ++i) {
+        if (!vertex[i]) candidates.push_back(i);
+    }
+    const unsigned int num = candidates.size();
+
+    std::vector<char> redundant(n, 0);
+    auto test_candidates = [&](const unsigned int t, const unsigned int step) {
+        std::vector<int> E;
+        std::vector<char> in_E(vertex), out(n, 0);
+        for (int i = 0; i < n; ++i) {
+            if (vertex[i]) E.push_back(i);
+        }
+        DenseLP<NT> lp;
+        bool lp_ready = false;
+        VT a(d);
+        for (unsigned int s = t; s < num; s += step) {
+            const int p = candidates[s];
+            while (!in_E[p]) {
+                if (!lp_ready) {
+                    MT UE(E.size(), d);
+                    for (unsigned int j = 0; j < E.size(); ++j) UE.row(j) = U.row(E[j]);
+                    memLP_Vpoly_model(UE, lp);
+                    lp_ready = true;
+                }
+                lp.b.head(d) = U.row(p).transpose();
+                if (lp.solve() == DenseLP<NT>::LP_OPTIMAL) {
+                    redundant[p] = out[p] = 1;
+                    break;
+                }
+
+                // the point that maximizes a^T x, of the largest ones the lexicographically largest
+                a = lp.infeasibility_certificate().head(d);
+                VT values = U * a;
+                int q = -1;
+                for (int i = 0; i < n; ++i) {
+                    if (out[i]) continue;
+                    if (q < 0 || values(i) > values(q) || (values(i) == values(q) && lex_less(U, q, i))) q = i;
+                }
+                if (in_E[q]) {
+                    // an inexact certificate: test p against all the other points
+                    DenseLP<NT> lp_all;
+                    memLP_Vpoly_model(U, lp_all);
+                    for (int i = 0; i < n; ++i) {
+                        if (out[i] || i == p) lp_all.u(i) = NT(0);
+                    }
+                    lp_all.b.head(d) = U.row(p).transpose();
+                    if (lp_all.solve() == DenseLP<NT>::LP_OPTIMAL) redundant[p] = out[p] = 1;
+                    break;
+                }
+                in_E[q] = 1;
+                E.push_back(q);
+                lp_ready = false;
+            }
+        }
+    };
+
+    const unsigned int threads = std::max(1u, std::min(n_threads, num));
+    if (threads == 1) {
+        test_candidates(0, 1);
+    } else {
+        std::vector<std::thread> workers;
+        for (unsigned int t = 0; t < threads; t++) workers.push_back(std::thread(test_candidates, t, threads));
+        for (unsigned int t = 0; t < threads; t++) workers[t].join();
+    }
+
+    std::vector<int> vertices;
+    for (int i = 0; i < n; ++i) {
+        if (!redundant[i]) vertices.push_back(rows[i]);
+    }
+    return vertices;
+}
+
+#endif
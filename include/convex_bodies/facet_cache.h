@@ -0,0 +1,198 @@
+// VolEsti (volume computation and sampling library)
+
+// Copyright (c) 20012-2019 Vissarion Fisikopoulos
+// Copyright (c) 2018-2019 Apostolos Chalkis
+
+// Licensed under GNU LGPL.3, see LICENCE file
+
+#ifndef FACET_CACHE_H
+#define FACET_CACHE_H
+
+#include <vector>
+#include <algorithm>
+#include <limits>
+#include <unordered_map>
+
+// Facets of a V-polytope found by the billiard walk. Each entry keeps the hyperplane a^T x = beta of
+// a facet (|a| = 1, a^T x <= beta on the polytope) and d vertices w_0,...,w_{d-1} of it.
+// The polytope lies in the intersection of the cached halfspaces, so a ray leaves the polytope no
+// later than it leaves that intersection. If the exit point of the intersection lies in the simplex
+// conv{w_0,...,w_{d-1}}, then it lies on the polytope and it is the exact exit point.
+// A facet is cached the second time the LP reports it, so the facets that a trajectory hits only
+// once do not pay its O(d^3) setup. When the cache is full the least recently hit facet is replaced.
+// A query costs O(d) per cached facet, which does not pay off for polytopes with many more facets
+// than the cache holds: if less than half of the queries of a window are certified, the cache is
+// suspended for the next 10 windows.
+template <typename Point>
+class FacetCache {
+public:
+    typedef typename Point::FT NT;
+    typedef Eigen::Matrix<NT, Eigen::Dynamic, Eigen::Dynamic> MT;
+    typedef Eigen::Matrix<NT, Eigen::Dynamic, 1> VT;
+
+private:
+    static const unsigned int window = 1000;
+    unsigned int _d, size, capacity, max_capacity;
+    bool fixed_capacity;
+    unsigned int window_queries, window_hits, suspended;
+    MT A;   // the normals, one per column
+    VT beta;
+    MT W0;  // the vertex w_0 of each facet, one per column
+    std::vector<MT> Binv;  // the inverse of [w_1-w_0, ..., w_{d-1}-w_0, a] of each facet
+    std::vector<unsigned long> last_hit;
+    unsigned long queries, hits;
+    VT Ar, Av, coeffs;
+    std::unordered_map<unsigned long, unsigned int> seen;  // hash of the vertices of a facet -> number of hits
+
+    static unsigned long hash(const std::vector<int> &idx) {
+        unsigned long h = 14695981039346656037ul;
+        for (unsigned int j = 0; j < idx.size(); ++j) h = (h ^ (unsigned long) idx[j]) * 1099511628211ul;
+        return h;
+    }
+
+public:
+    FacetCache() : _d(0), size(0), capacity(0), max_capacity(0), fixed_capacity(false), queries(0), hits(0) {}
+
+    // by default keep up to 1000 facets, or fewer in high dimension so that the cache takes at most
+    // 2^21 numbers; the storage grows with the number of cached facets
+    void init(const unsigned int dim) {
+        _d = dim;
+        capacity = fixed_capacity ? max_capacity :
+                   std::max(10u, std::min(1000u, (1u << 21) / std::max(1u, _d * _d)));
+        A.resize(_d, 0);
+        beta.resize(0);
+        W0.resize(_d, 0);
+        Binv.clear();
+        last_hit.clear();
+        size = 0;
+        queries = hits = 0;
+        window_queries = window_hits = suspended = 0;
+        seen.clear();
+    }
+
+    // the maximum number of cached facets instead of the default, 0 disables the cache; it clears the cache
+    void set_capacity(const unsigned int cap) {
+        max_capacity = cap;
+        fixed_capacity = true;
+        init(_d);
+    }
+
+    unsigned int num_of_facets() const {
+        return size;
+    }
+
+    unsigned long num_of_queries() const {
+        return queries;
+    }
+
+    unsigned long num_of_hits() const {
+        return hits;
+    }
+
+    // the unit normal of the i-th cached facet, pointing out of the polytope
+    typename MT::ConstColXpr normal(const int i) const {
+        return A.col(i);
+    }
+
+    NT offset(const int i) const {
+        return beta(i);
+    }
+
+    // the LP hit the facet through the rows idx of V (in increasing order); r is an interior point of the
+    // polytope. Cache the facet if it is its second hit and return its index, otherwise return -1
+    template <typename MT2>
+    int add(const MT2 &V, const std::vector<int> &idx, const Point &r) {
+        if (capacity == 0 || suspended > 0 || idx.size() != _d) return -1;
+
+        if (seen.size() > 16 * capacity) seen.clear();
+        if (++seen[hash(idx)] < 2) return -1;
+
+        MT E(_d, _d);
+        VT w0 = V.row(idx[0]).transpose();
+        for (unsigned int j = 1; j < _d; ++j) E.col(j - 1) = V.row(idx[j]).transpose() - w0;
+
+        VT a(_d);
+        if (_d == 1) {
+            a(0) = NT(1);
+        } else {
+            Eigen::FullPivLU<MT> lu(E.leftCols(_d - 1).transpose());
+            if (lu.rank() != int(_d) - 1) return -1;
+            a = lu.kernel().col(0);
+        }
+        a.normalize();
+        if (a.dot(w0 - r.map()) < NT(0)) a = -a;
+        E.col(_d - 1) = a;
+
+        Eigen::FullPivLU<MT> lu2(E);
+        if (!lu2.isInvertible()) return -1;
+
+        unsigned int i = size;
+        if (size < capacity) {
+            if (size == Binv.size()) {
+                unsigned int cols = std::min(capacity, std::max(16u, 2 * size));
+                A.conservativeResize(_d, cols);
+                beta.conservativeResize(cols);
+                W0.conservativeResize(_d, cols);
+                Binv.resize(cols);
+                last_hit.resize(cols, 0);
+            }
+            size++;
+        } else {
+            i = std::min_element(last_hit.begin(), last_hit.end()) - last_hit.begin();
+        }
+        A.col(i) = a;
+        beta(i) = a.dot(w0);
+        W0.col(i) = w0;
+        Binv[i] = lu2.inverse();
+        last_hit[i] = queries;
+        return i;
+    }
+
+    // the exit point of the ray r + t v, t >= 0, from the polytope if it is certified by a cached facet.
+    // Return the index of the facet and set t, or return -1
+    int intersect(const Point &r, const Point &v, NT &t) {
+        queries++;
+        if (suspended > 0) {
+            suspended--;
+            return -1;
+        }
+        if (++window_queries == window) {
+            if (2 * window_hits < window) suspended = 10 * window;
+            window_queries = window_hits = 0;
+        }
+        if (size == 0) return -1;
+
+        Ar.noalias() = A.leftCols(size).transpose() * r.map();
+        Av.noalias() = A.leftCols(size).transpose() * v.map();
+
+        int facet = -1;
+        t = std::numeric_limits<NT>::max();
+        for (unsigned int i = 0; i < size; ++i) {
+            if (Av(i) > NT(0)) {
+                NT ti = (beta(i) - Ar(i)) / Av(i);
+                if (ti < t) {
+                    t = ti;
+                    facet = i;
+                }
+            }
+        }
+        if (facet < 0 || t < NT(0)) return -1;
+
+        // barycentric coordinates of the exit point in the simplex of the facet
+        const NT tol = NT(1e-10);
+        coeffs.noalias() = Binv[facet] * (r.map() + t * v.map() - W0.col(facet));
+        NT sum = NT(0);
+        for (unsigned int j = 0; j + 1 < _d; ++j) {
+            if (coeffs(j) < -tol) return -1;
+            sum += coeffs(j);
+        }
+        if (sum > NT(1) + tol) return -1;
+
+        last_hit[facet] = queries;
+        hits++;
+        window_hits++;
+        return facet;
+    }
+};
+
+#endif
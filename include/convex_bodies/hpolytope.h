@@ -14,6 +14,7 @@
 
 #include <iostream>
 #include "solve_lp.h"
+#include "diameter.h"
 
 //min and max values for the Hit and Run functions
 
@@ -29,9 +30,12 @@ public:
     //typedef RowMatrixXd MT;
     typedef Eigen::Matrix<NT,Eigen::Dynamic,Eigen::Dynamic> MT;
     typedef Eigen::Matrix<NT,Eigen::Dynamic,1> VT;
+    // A has as many columns as the dimension of the points, so if the dimension is fixed
+    // at compile time the products with the points are fixed-size and unrolled
+    typedef Eigen::Matrix<NT,Eigen::Dynamic,Point::fixed_dim> AMT;
 
 private:
-    MT A; //matrix A
+    AMT A; //matrix A
     VT b; // vector b, s.t.: Ax<=b
     unsigned int            _d; //dimension
     //NT maxNT = 1.79769e+308;
@@ -138,7 +142,18 @@ public:
         return 0.0;
     }
 
+    // the support function h(u) = max {u^T x : x in P} and a point of P that attains it
+    std::pair<Point,NT> support(const Point &u) const {
+        VT x;
+        NT h = support_Hpoly(MT(A.transpose()), VT(b), VT(u.map()), x);
+        return std::pair<Point,NT>(Point(x), h);
+    }
+
+    // estimate the diameter from support queries (see approx_diameter()); if the LPs fail, use
+    // 4 sqrt(d) times the radius cheb_rad of the inscribed ball
     void comp_diam(NT &diam, const NT &cheb_rad) {
+        approx_diameter<Point>(*this, diam);
+        if (diam > NT(0)) return;
         if(cheb_rad < 0.0) {
             diam = 4.0 * std::sqrt(NT(_d)) * ComputeInnerBall().second;
         } else {
@@ -251,15 +266,9 @@ public:
     
     //Check if Point p is in H-polytope P:= Ax<=b
     int is_in(const Point &p) const {
-        NT sum;
-        int m = A.rows();
-        for (int i = 0; i < m; i++) {
-            sum = b(i);
-            for (unsigned int j = 0; j < _d; j++) sum -= A(i, j) * p[j];
-
-            //Check if corresponding hyperplane is violated
-            if (sum < NT(0)) return 0;
-        }
+        // A is stored column-major, so A*p is computed column by column (contiguous, vectorized)
+        // and then compared to b, instead of a strided dot product for each facet
+        if (((A * p.map()) - b).maxCoeff() > NT(0)) return 0;
         return -1;
     }
 
@@ -279,21 +288,12 @@ public:
 
         NT lamda = 0, min_plus = NT(maxNT), max_minus = NT(minNT);
         NT sum_nom, sum_denom;
-        //unsigned int i, j;
-        unsigned int j;
         int m = num_of_hyperplanes();
-        viterator rit, vit;
+        VT Ar = A * r.map(), Av = A * v.map();
 
         for (int i = 0; i < m; i++) {
-            sum_nom = b(i);
-            sum_denom = NT(0);
-            j = 0;
-            rit = r.iter_begin();
-            vit = v.iter_begin();
-            for ( ; rit != r.iter_end(); rit++, vit++, j++){
-                sum_nom -= A(i, j) * (*rit);
-                sum_denom += A(i, j) * (*vit);
-            }
+            sum_nom = b(i) - Ar(i);
+            sum_denom = Av(i);
             if (sum_denom == NT(0)) {
                 //std::cout<<"div0"<<std::endl;
                 ;
@@ -313,25 +313,16 @@ public:
             std::vector<NT> &Av, bool pos = false) {
 
         NT lamda = 0, min_plus = NT(maxNT), max_minus = NT(minNT);
-        NT sum_nom, sum_denom, mult;
-        //unsigned int i, j;
-        unsigned int j;
+        NT sum_nom, sum_denom;
         int m = num_of_hyperplanes(), facet;
-        viterator rit, vit, Ariter = Ar.begin(), Aviter = Av.begin();
+        viterator Ariter = Ar.begin(), Aviter = Av.begin();
+
+        Eigen::Map<VT>(&Ar[0], m).noalias() = A * r.map();
+        Eigen::Map<VT>(&Av[0], m).noalias() = A * v.map();
 
         for (int i = 0; i < m; i++, ++Ariter, ++Aviter) {
-            sum_nom = NT(0);
-            sum_denom = NT(0);
-            j = 0;
-            rit = r.iter_begin();
-            vit = v.iter_begin();
-            for ( ; rit != r.iter_end(); rit++, vit++, j++){
-                sum_nom -= A(i, j) * (*rit);
-                sum_denom += A(i, j) * (*vit);
-            }
-            (*Ariter) = -sum_nom;
-            (*Aviter) = sum_denom;
-            sum_nom += b(i);
+            sum_nom = b(i) - (*Ariter);
+            sum_denom = (*Aviter);
             if (sum_denom == NT(0)) {
                 //std::cout<<"div0"<<std::endl;
                 ;
@@ -351,21 +342,18 @@ public:
             std::vector<NT> &Av, const NT &lambda_prev, bool pos = false) {
 
         NT lamda = 0, min_plus = NT(maxNT), max_minus = NT(minNT);
-        NT sum_nom, sum_denom, mult;
-        //unsigned int i, j;
-        unsigned int j;
+        NT sum_nom, sum_denom;
         int m = num_of_hyperplanes(), facet;
-        viterator vit, Ariter = Ar.begin(), Aviter = Av.begin();
+        viterator Ariter = Ar.begin(), Aviter = Av.begin();
+
+        // update A*r for the new point r = r_prev + lambda_prev*v_prev and compute A*v
+        Eigen::Map<VT> Armap(&Ar[0], m), Avmap(&Av[0], m);
+        Armap += lambda_prev * Avmap;
+        Avmap.noalias() = A * v.map();
 
         for (int i = 0; i < m; i++, ++Ariter, ++Aviter) {
-            (*Ariter) += lambda_prev * (*Aviter);
             sum_nom = b(i) - (*Ariter);
-            sum_denom = NT(0);
-            j = 0;
-            vit = v.iter_begin();
-            for ( ; vit != v.iter_end(); vit++, j++) sum_denom += A(i, j) * (*vit);
-
-            (*Aviter) = sum_denom;
+            sum_denom = (*Aviter);
             if (sum_denom == NT(0)) {
                 //std::cout<<"div0"<<std::endl;
                 ;
@@ -382,6 +370,28 @@ public:
     }
 
 
+    // block ray shooting for K chains: the k-th columns of R and V are the point and the direction
+    // of the k-th chain. AR = A*R and AV = A*V are computed with one matrix-matrix product each,
+    // so A is read once for all the chains. The chord of the k-th chain is [max_minus(k), min_plus(k)]
+    void line_intersect(const MT &R, const MT &V, MT &AR, MT &AV, VT &min_plus, VT &max_minus) {
+
+        AR.noalias() = A * R;
+        AV.noalias() = A * V;
+        chords_of_chains(AR, AV, min_plus, max_minus);
+    }
+
+
+    // block ray shooting for K chains that moved to R = R_prev + V_prev * diag(lambdas_prev),
+    // where AR and AV hold A*R_prev and A*V_prev
+    void line_intersect(const MT &R, const MT &V, MT &AR, MT &AV, const VT &lambdas_prev,
+                        VT &min_plus, VT &max_minus) {
+
+        AR.noalias() += AV * lambdas_prev.asDiagonal();
+        AV.noalias() = A * V;
+        chords_of_chains(AR, AV, min_plus, max_minus);
+    }
+
+
     // compute intersection point of a ray starting from r and pointing to v
     // with polytope discribed by A and b
     std::pair<NT, int> line_positive_intersect(Point &r, Point &v, std::vector<NT> &Ar,
@@ -404,19 +414,13 @@ public:
 
         NT lamda = 0, min_plus = NT(maxNT), max_minus = NT(minNT);
         NT sum_nom, sum_denom;
-        unsigned int j;
         int m = num_of_hyperplanes();
-        viterator rit;
+
+        Eigen::Map<VT>(&lamdas[0], m).noalias() = b - A * r.map();
 
         for (int i = 0; i < m; i++) {
-            sum_nom = b(i);
+            sum_nom = lamdas[i];
             sum_denom = A(i, rand_coord);
-            rit = r.iter_begin();
-            j = 0;
-            for (; rit != r.iter_end(); rit++, j++) {
-                sum_nom -= A(i, j) * (*rit);
-            }
-            lamdas[i] = sum_nom;
             if (sum_denom == NT(0)) {
                 //std::cout<<"div0"<<sum_denom<<std::endl;
                 ;
@@ -440,15 +444,14 @@ public:
 
         viterator lamdait = lamdas.begin();
         NT lamda = 0, min_plus = NT(maxNT), max_minus = NT(minNT);
-        NT sum_nom, sum_denom, c_rand_coord, c_rand_coord_prev;
+        NT c_rand_coord;
         int m = num_of_hyperplanes();
 
+        // the columns of A are contiguous, so the update of b-A*r is a vectorized axpy
+        Eigen::Map<VT>(&lamdas[0], m) += (r_prev[rand_coord_prev] - r[rand_coord_prev]) * A.col(rand_coord_prev);
+
         for (int i = 0; i < m; i++) {
-            sum_denom = b(i);
             c_rand_coord = A(i, rand_coord);
-            c_rand_coord_prev = A(i, rand_coord_prev);
-
-            *lamdait = *lamdait + c_rand_coord_prev * (r_prev[rand_coord_prev] - r[rand_coord_prev]);
             if (c_rand_coord == NT(0)) {
                 //std::cout<<"div0"<<std::endl;
                 ;
@@ -511,15 +514,30 @@ public:
 
     void compute_reflection(Point &v, const Point &p, const int facet) {
 
-        VT a = A.row(facet);
-        Point s(_d, std::vector<NT>(&a[0], a.data()+a.cols()*a.rows()));
-        s = ((-2.0 * v.dot(s)) * s);
-        v = s + v;
+        v.map() -= (2.0 * v.map().dot(A.row(facet).transpose())) * A.row(facet).transpose();
 
     }
 
     void free_them_all() {}
 
+private:
+
+    // the minimum positive and the maximum negative (b(i) - AR(i,k)) / AV(i,k) for each column k
+    void chords_of_chains(const MT &AR, const MT &AV, VT &min_plus, VT &max_minus) const {
+
+        int K = AR.cols();
+        VT lamdas(AR.rows());
+        min_plus.resize(K);
+        max_minus.resize(K);
+
+        for (int k = 0; k < K; ++k) {
+            // a zero denominator gives +-inf or nan, which can not be selected below
+            lamdas = (b - AR.col(k)).cwiseQuotient(AV.col(k));
+            min_plus(k) = std::min(maxNT, (lamdas.array() > NT(0)).select(lamdas, maxNT).minCoeff());
+            max_minus(k) = std::max(minNT, (lamdas.array() < NT(0)).select(lamdas, minNT).maxCoeff());
+        }
+    }
+
 };
 
 #endif
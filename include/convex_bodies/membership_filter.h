@@ -0,0 +1,229 @@
+// VolEsti (volume computation and sampling library)
+
+// Copyright (c) 20012-2019 Vissarion Fisikopoulos
+// Copyright (c) 2018-2019 Apostolos Chalkis
+
+// Licensed under GNU LGPL.3, see LICENCE file
+
+#ifndef MEMBERSHIP_FILTER_H
+#define MEMBERSHIP_FILTER_H
+
+#include <limits>
+#include <iostream>
+#include <vector>
+#include <algorithm>
+
+// Cheap tests in front of the membership LP of V-polytopes and zonotopes.
+// Layers, in order of cost:
+//  1. reject if the point lies out of the axis-aligned bounding box, O(d)
+//  2. reject if the point lies out of the bounding box along the principal axes (PCA box), O(d^2)
+//  3. accept if the point lies in the cross-polytope conv{c + t_i^+ u_i, c - t_i^- u_i},
+//     where u_i are the principal axes and c +/- t_i^{+/-} u_i are boundary points. O(d) after 2.
+//  4. reject if the point violates a cached halfspace of the body, O(d) per halfspace.
+//     The halfspaces are learned from the LP of rejected points (add_halfspace()); when the cache
+//     is full the least recently violated one is replaced.
+// Only the points in the band between the cross-polytope and the boxes that satisfy all the cached
+// halfspaces need the LP.
+template <typename Point>
+class MembershipFilter {
+public:
+    typedef typename Point::FT NT;
+    typedef Eigen::Matrix<NT, Eigen::Dynamic, Eigen::Dynamic> MT;
+    typedef Eigen::Matrix<NT, Eigen::Dynamic, 1> VT;
+
+private:
+    VT box_min, box_max;  // axis-aligned bounding box
+    VT c;  // center of the PCA box and of the cross-polytope
+    MT U;  // principal axes, one per column
+    VT pca_min, pca_max;  // U^T (P - c) lies in [pca_min, pca_max]
+    VT inv_plus, inv_minus;  // 1/t_i^+ and 1/t_i^- of the cross-polytope
+    VT y;  // U^T (p - c) of the last query
+    MT H;  // normals of the cached halfspaces H.col(i)^T x <= beta(i)
+    VT beta;
+    std::vector<unsigned long> last_hit;  // the query of the last rejection by each cached halfspace
+    unsigned int cache_size, cache_capacity;
+    unsigned long queries;
+    bool ready;
+    unsigned long box_rejects, pca_rejects, inner_accepts, cache_rejects, lp_calls;
+
+    // principal axes of the rows of the centered matrix X
+    void set_axes(const MT &X) {
+        MT S = X.transpose() * X;
+        S = (S + S.transpose()) / 2.0;
+        Eigen::SelfAdjointEigenSolver<MT> es(S);
+        U = es.eigenvectors();
+    }
+
+    void clear_inner() {
+        const unsigned int d = c.rows();
+        inv_plus.setConstant(d, std::numeric_limits<NT>::infinity());
+        inv_minus.setConstant(d, std::numeric_limits<NT>::infinity());
+        y.resize(d);
+        H.resize(d, cache_capacity);
+        beta.resize(cache_capacity);
+        last_hit.assign(cache_capacity, 0);
+        cache_size = 0;
+        queries = 0;
+        ready = false;
+    }
+
+public:
+    MembershipFilter() : cache_size(0), cache_capacity(32), queries(0), ready(false) {
+        reset_stats();
+    }
+
+    // the boxes of the convex hull of the rows of V
+    void init_vpolytope(const MT &V) {
+        box_min = V.colwise().minCoeff().transpose();
+        box_max = V.colwise().maxCoeff().transpose();
+        c = V.colwise().mean().transpose();
+        MT X = V.rowwise() - c.transpose();
+        set_axes(X);
+        MT XU = X * U;
+        pca_min = XU.colwise().minCoeff().transpose();
+        pca_max = XU.colwise().maxCoeff().transpose();
+        clear_inner();
+    }
+
+    // the boxes of the zonotope {V^T lambda, lambda in [-1,1]^k}, which are given by its support function
+    void init_zonotope(const MT &V) {
+        box_max = V.cwiseAbs().colwise().sum().transpose();
+        box_min = -box_max;
+        c = VT::Zero(V.cols());
+        set_axes(V);
+        pca_max = (V * U).cwiseAbs().colwise().sum().transpose();
+        pca_min = -pca_max;
+        clear_inner();
+    }
+
+    unsigned int dimension() const {
+        return c.rows();
+    }
+
+    Point center() const {
+        return Point(c);
+    }
+
+    Point axis(const unsigned int i) const {
+        return Point(U.col(i));
+    }
+
+    // c + t_plus * axis(i) and c - t_minus * axis(i) are points of the body
+    void set_inner_axis(const unsigned int i, const NT &t_plus, const NT &t_minus) {
+        const NT inf = std::numeric_limits<NT>::infinity();
+        inv_plus(i) = (t_plus > 0.0) ? 1.0 / t_plus : inf;
+        inv_minus(i) = (t_minus > 0.0) ? 1.0 / t_minus : inf;
+    }
+
+    // the filter is used only after init_*() and set_inner_axis() for every axis
+    void set_ready() {
+        ready = true;
+    }
+
+    void clear() {
+        ready = false;
+    }
+
+    // the maximum number of cached halfspaces; it clears the cache
+    void set_cache_capacity(const unsigned int capacity) {
+        cache_capacity = capacity;
+        H.resize(dimension(), cache_capacity);
+        beta.resize(cache_capacity);
+        last_hit.assign(cache_capacity, 0);
+        cache_size = 0;
+    }
+
+    unsigned int num_cached_halfspaces() const {
+        return cache_size;
+    }
+
+    // cache the halfspace a^T x <= b of the body
+    template <typename VT2>
+    void add_halfspace(const VT2 &a, const NT &b) {
+        if (cache_capacity == 0) return;
+        unsigned int i = cache_size;
+        if (cache_size < cache_capacity) {
+            cache_size++;
+        } else {
+            i = std::min_element(last_hit.begin(), last_hit.end()) - last_hit.begin();
+        }
+        H.col(i) = a;
+        beta(i) = b;
+        last_hit[i] = queries;
+    }
+
+    // return -1 if p is in the body, 0 if p is out of the body and 1 if the LP has to decide
+    int test(const Point &p) {
+        if (!ready) return 1;
+        queries++;
+
+        const NT tol = 0.0000000001;
+        Eigen::Map<const typename Point::VT> pm = p.map();
+        for (unsigned int i = 0; i < dimension(); ++i) {
+            if (pm(i) < box_min(i) - tol * (1.0 + std::abs(box_min(i))) ||
+                pm(i) > box_max(i) + tol * (1.0 + std::abs(box_max(i)))) {
+                box_rejects++;
+                return 0;
+            }
+        }
+
+        y.noalias() = U.transpose() * (pm - c);
+        NT sum = 0.0;
+        for (unsigned int i = 0; i < dimension(); ++i) {
+            if (y(i) < pca_min(i) - tol * (1.0 + std::abs(pca_min(i))) ||
+                y(i) > pca_max(i) + tol * (1.0 + std::abs(pca_max(i)))) {
+                pca_rejects++;
+                return 0;
+            }
+            sum += (y(i) > 0.0) ? y(i) * inv_plus(i) : (y(i) < 0.0 ? -y(i) * inv_minus(i) : 0.0);
+        }
+        if (sum < 1.0 - tol) {
+            inner_accepts++;
+            return -1;
+        }
+
+        for (unsigned int i = 0; i < cache_size; ++i) {
+            if (H.col(i).dot(pm) > beta(i) + tol * (1.0 + std::abs(beta(i)))) {
+                last_hit[i] = queries;
+                cache_rejects++;
+                return 0;
+            }
+        }
+
+        lp_calls++;
+        return 1;
+    }
+
+    void reset_stats() {
+        box_rejects = pca_rejects = inner_accepts = cache_rejects = lp_calls = 0;
+    }
+
+    unsigned long num_box_rejects() const {
+        return box_rejects;
+    }
+
+    unsigned long num_pca_rejects() const {
+        return pca_rejects;
+    }
+
+    unsigned long num_inner_accepts() const {
+        return inner_accepts;
+    }
+
+    unsigned long num_cache_rejects() const {
+        return cache_rejects;
+    }
+
+    unsigned long num_lp_calls() const {
+        return lp_calls;
+    }
+
+    void print_stats() const {
+        unsigned long total = box_rejects + pca_rejects + inner_accepts + cache_rejects + lp_calls;
+        std::cout << "membership queries = " << total << ", box rejects = " << box_rejects
+                  << ", PCA box rejects = " << pca_rejects << ", inner accepts = " << inner_accepts
+                  << ", cached halfspace rejects = " << cache_rejects << ", LP calls = " << lp_calls << std::endl;
+    }
+};
+
+#endif
@@ -0,0 +1,427 @@
+// VolEsti (volume computation and sampling library)
+
+// Copyright (c) 20012-2019 Vissarion Fisikopoulos
+// Copyright (c) 2018-2019 Apostolos Chalkis
+
+// Licensed under GNU LGPL.3, see LICENCE file
+
+#ifndef SPARSE_HPOLYTOPE_H
+#define SPARSE_HPOLYTOPE_H
+
+#include <limits>
+
+#include <iostream>
+#include "solve_lp.h"
+#include "diameter.h"
+
+
+// H-polytope class with a sparse matrix A, e.g. order polytopes or products of simplices.
+// A is kept both in CSR (rows: membership, reflections, normalization) and in CSC (columns: CDHR),
+// so the coordinate directions visit only the nonzeros of one column.
+// A linear transformation (rounding) is not applied to A, since A*T is dense; it is stored in T
+// and the polytope is {y : A*T*y <= b}.
+template <typename Point>
+class SparseHPolytope{
+public:
+    typedef Point PolytopePoint;
+    typedef typename Point::FT NT;
+    typedef typename std::vector<NT>::iterator viterator;
+    typedef Eigen::Matrix<NT,Eigen::Dynamic,Eigen::Dynamic> MT;
+    typedef Eigen::Matrix<NT,Eigen::Dynamic,1> VT;
+    typedef Eigen::SparseMatrix<NT, Eigen::RowMajor> SpMT;
+    typedef Eigen::SparseMatrix<NT, Eigen::ColMajor> SpMTcol;
+
+private:
+    SpMT A; // matrix A in CSR
+    SpMTcol Acol; // matrix A in CSC
+    VT b; // vector b, s.t.: A*T*x<=b
+    MT T; // linear transformation, it is used only if transformed = true
+    bool transformed;
+    unsigned int            _d; //dimension
+    NT maxNT = std::numeric_limits<NT>::max();
+    NT minNT = std::numeric_limits<NT>::lowest();
+
+    // x = T*p
+    VT map_point(const Point &p) const {
+        if (transformed) return T * Eigen::Map<const VT>(p.data(), _d);
+        return Eigen::Map<const VT>(p.data(), _d);
+    }
+
+    // the facet-th row of A*T
+    VT row_of(const int &facet) const {
+        VT a = A.row(facet).transpose().toDense();
+        if (transformed) return T.transpose() * a;
+        return a;
+    }
+
+    // the lambdas of the chord: the minimum positive and the maximum negative lamdas[i] / Ad[i]
+    std::pair<NT,NT> chord(const std::vector<NT> &lamdas, const VT &Ad) const {
+
+        NT lamda, min_plus = NT(maxNT), max_minus = NT(minNT);
+        int m = num_of_hyperplanes();
+
+        for (int i = 0; i < m; i++) {
+            if (Ad(i) == NT(0)) continue;
+            lamda = lamdas[i] / Ad(i);
+            if (lamda < min_plus && lamda > 0) min_plus = lamda;
+            if (lamda > max_minus && lamda < 0) max_minus = lamda;
+        }
+        return std::pair<NT, NT>(min_plus, max_minus);
+    }
+
+    // the same as chord() for the column rand_coord of A, visiting only its nonzeros
+    std::pair<NT,NT> chord_coord(const std::vector<NT> &lamdas, const unsigned int &rand_coord) const {
+
+        NT lamda, min_plus = NT(maxNT), max_minus = NT(minNT);
+
+        for (typename SpMTcol::InnerIterator it(Acol, rand_coord); it; ++it) {
+            if (it.value() == NT(0)) continue;
+            lamda = lamdas[it.row()] / it.value();
+            if (lamda < min_plus && lamda > 0) min_plus = lamda;
+            if (lamda > max_minus && lamda < 0) max_minus = lamda;
+        }
+        return std::pair<NT, NT>(min_plus, max_minus);
+    }
+
+public:
+    SparseHPolytope() : transformed(false) {}
+
+
+    // return dimension
+    unsigned int dimension() const {
+        return _d;
+    }
+
+
+    // return the number of facets
+    int num_of_hyperplanes() const {
+        return A.rows();
+    }
+
+
+    // return the number of nonzeros of A
+    int num_of_nonzeros() const {
+        return A.nonZeros();
+    }
+
+
+    // return the matrix A*T as a dense matrix
+    MT get_mat() const {
+        if (transformed) return A * T;
+        return A.toDense();
+    }
+
+
+    // return the sparse matrix A (without the linear transformation)
+    SpMT get_sparse_mat() const {
+        return A;
+    }
+
+
+    // return the vector b
+    VT get_vec() const {
+        return b;
+    }
+
+
+    // change the vector b
+    void set_vec(const VT &b2) {
+        b = b2;
+    }
+
+
+    // get a specific coeff of matrix A*T
+    NT get_mat_coeff(const unsigned int &i, const unsigned int &j) const {
+        if (transformed) return A.row(i).dot(T.col(j));
+        return A.coeff(i,j);
+    }
+
+
+    // get a spesific coeff of vector b
+    NT get_vec_coeff(const unsigned int &i) const {
+        return b(i);
+    }
+
+
+    // set a spesific coeff of vector b
+    void put_vec_coeff(const unsigned int &i, const NT &value) {
+        b(i) = value;
+    }
+
+
+    Point get_mean_of_vertices() const {
+        return Point(_d);
+    }
+
+
+    NT get_max_vert_norm() const {
+        return 0.0;
+    }
+
+    // the support function h(u) = max {u^T x : x in P} and a point of P that attains it
+    std::pair<Point,NT> support(const Point &u) const {
+        VT x;
+        NT h = support_Hpoly(MT(get_mat().transpose()), VT(b), VT(u.map()), x);
+        return std::pair<Point,NT>(Point(x), h);
+    }
+
+    // estimate the diameter from support queries (see approx_diameter()); if the LPs fail, use
+    // 4 sqrt(d) times the radius cheb_rad of the inscribed ball
+    void comp_diam(NT &diam, const NT &cheb_rad) {
+        approx_diameter<Point>(*this, diam);
+        if (diam > NT(0)) return;
+        if(cheb_rad < 0.0) {
+            diam = 4.0 * std::sqrt(NT(_d)) * ComputeInnerBall().second;
+        } else {
+            diam = 4.0 * std::sqrt(NT(_d)) * cheb_rad;
+        }
+    }
+
+    void init(const unsigned int dim, const SpMT &_A, const VT &_b) {
+        _d = dim;
+        A = _A;
+        A.makeCompressed();
+        Acol = A;
+        b = _b;
+        transformed = false;
+    }
+
+    // keep only the nonzeros of a dense matrix A
+    void init(const unsigned int dim, const MT &_A, const VT &_b) {
+        init(dim, SpMT(_A.sparseView()), _b);
+    }
+
+    //define matrix A and vector b, s.t. Ax<=b and the dimension
+    void init(const std::vector<std::vector<NT> > &Pin) {
+        unsigned int dim = Pin[0][1] - 1;
+        std::vector<Eigen::Triplet<NT> > nonzeros;
+        SpMT A2(Pin.size() - 1, dim);
+        VT b2(Pin.size() - 1);
+        for (unsigned int i = 1; i < Pin.size(); i++) {
+            b2(i - 1) = Pin[i][0];
+            for (unsigned int j = 1; j < dim + 1; j++) {
+                if (Pin[i][j] != NT(0)) nonzeros.push_back(Eigen::Triplet<NT>(i - 1, j - 1, -Pin[i][j]));
+            }
+        }
+        A2.setFromTriplets(nonzeros.begin(), nonzeros.end());
+        init(dim, A2, b2);
+    }
+
+
+    // print polytope in input format
+    void print() {
+#ifdef VOLESTI_DEBUG
+        std::cout << " " << A.rows() << " " << _d + 1 << " float" << std::endl;
+        MT A2 = get_mat();
+        for (unsigned int i = 0; i < A2.rows(); i++) {
+            for (unsigned int j = 0; j < _d; j++) {
+                std::cout << -A2(i, j) << " ";
+            }
+            std::cout << "<= " << b(i) << std::endl;
+        }
+#endif
+    }
+
+
+    //Check if Point p is in H-polytope P:= A*T*x<=b
+    int is_in(const Point &p) const {
+        VT x = map_point(p);
+        int m = A.rows();
+        for (int i = 0; i < m; i++) {
+            //Check if corresponding hyperplane is violated
+            if (A.row(i).dot(x) > b(i)) return 0;
+        }
+        return -1;
+    }
+
+
+    //Compute Chebyshev ball of H-polytope P:= A*T*x<=b
+    //Use LpSolve library
+    std::pair<Point,NT> ComputeInnerBall() {
+
+        if (transformed) {
+            MT A2 = A * T;
+            return ComputeChebychevBall<NT, Point>(A2, b);
+        }
+        return ComputeChebychevBall<NT, Point>(A, b);
+    }
+
+
+    // compute intersection point of ray starting from r and pointing to v
+    // with polytope discribed by A*T and b
+    std::pair<NT,NT> line_intersect(Point &r, Point &v) {
+
+        int m = num_of_hyperplanes();
+        std::vector<NT> lamdas(m);
+        VT Av = A * map_point(v);
+        Eigen::Map<VT>(&lamdas[0], m) = b - A * map_point(r);
+        return chord(lamdas, Av);
+    }
+
+
+    // compute intersection points of a ray starting from r and pointing to v
+    // with polytope discribed by A*T and b
+    std::pair<NT,NT> line_intersect(Point &r, Point &v, std::vector<NT> &Ar,
+            std::vector<NT> &Av, bool pos = false) {
+
+        int m = num_of_hyperplanes();
+        Eigen::Map<VT>(&Ar[0], m).noalias() = A * map_point(r);
+        Eigen::Map<VT>(&Av[0], m).noalias() = A * map_point(v);
+        return ray_facet(Ar, Av, pos);
+    }
+
+    std::pair<NT,NT> line_intersect(Point &r, Point &v, std::vector<NT> &Ar,
+            std::vector<NT> &Av, const NT &lambda_prev, bool pos = false) {
+
+        int m = num_of_hyperplanes();
+        Eigen::Map<VT> Armap(&Ar[0], m), Avmap(&Av[0], m);
+        Armap += lambda_prev * Avmap;
+        Avmap.noalias() = A * map_point(v);
+        return ray_facet(Ar, Av, pos);
+    }
+
+
+    // compute intersection point of a ray starting from r and pointing to v
+    // with polytope discribed by A*T and b
+    std::pair<NT, int> line_positive_intersect(Point &r, Point &v, std::vector<NT> &Ar,
+            std::vector<NT> &Av) {
+        return line_intersect(r, v, Ar, Av, true);
+    }
+
+
+    // compute intersection point of a ray starting from r and pointing to v
+    // with polytope discribed by A*T and b
+    std::pair<NT, int> line_positive_intersect(Point &r, Point &v, std::vector<NT> &Ar,
+            std::vector<NT> &Av, const NT &lambda_prev) {
+        return line_intersect(r, v, Ar, Av, lambda_prev, true);
+    }
+
+
+    //First coordinate ray intersecting convex polytope
+    std::pair<NT,NT> line_intersect_coord(Point &r, const unsigned int &rand_coord,
+                                          std::vector<NT> &lamdas) {
+
+        int m = num_of_hyperplanes();
+        Eigen::Map<VT>(&lamdas[0], m).noalias() = b - A * map_point(r);
+
+        if (transformed) return chord(lamdas, A * T.col(rand_coord));
+        return chord_coord(lamdas, rand_coord);
+    }
+
+
+    //Not the first coordinate ray intersecting convex
+    std::pair<NT,NT> line_intersect_coord(Point &r,
+                                          const Point &r_prev,
+                                          const unsigned int rand_coord,
+                                          const unsigned int rand_coord_prev,
+                                          std::vector<NT> &lamdas) {
+
+        NT delta = r_prev[rand_coord_prev] - r[rand_coord_prev];
+
+        if (transformed) {
+            int m = num_of_hyperplanes();
+            Eigen::Map<VT>(&lamdas[0], m) += delta * (A * T.col(rand_coord_prev));
+            return chord(lamdas, A * T.col(rand_coord));
+        }
+
+        // only the facets with a nonzero coefficient at rand_coord_prev are updated
+        for (typename SpMTcol::InnerIterator it(Acol, rand_coord_prev); it; ++it) {
+            lamdas[it.row()] += it.value() * delta;
+        }
+        return chord_coord(lamdas, rand_coord);
+    }
+
+
+    // Apply linear transformation, of square matrix T^{-1}, in H-polytope P:= A*T*x<=b
+    void linear_transformIt(const MT &T2) {
+        if (transformed) {
+            T = T * T2;
+        } else {
+            T = T2;
+            transformed = true;
+        }
+    }
+
+
+    // shift polytope by a point c
+    void shift(const VT &c){
+        if (transformed) {
+            b = b - A * (T * c);
+        } else {
+            b = b - A * c;
+        }
+    }
+
+
+    // return for each facet the distance from the origin
+    std::vector<NT> get_dists(const NT &radius){
+        std::vector <NT> dists(num_of_hyperplanes(), NT(0));
+        for (int i = 0; i < num_of_hyperplanes(); i++) dists[i] = b(i) / row_of(i).norm();
+
+        return dists;
+    }
+
+
+    // no points given for the rounding, you have to sample from the polytope
+    template <typename T2>
+    bool get_points_for_rounding (const T2 &randPoints) {
+        return false;
+    }
+
+    MT get_T() const {
+        return get_mat();
+    }
+
+    void normalize() {
+
+        VT row_norms(num_of_hyperplanes());
+        for (int i = 0; i < num_of_hyperplanes(); ++i) {
+            row_norms(i) = transformed ? row_of(i).norm() : A.row(i).norm();
+        }
+        row_norms = row_norms.cwiseInverse();
+        A = row_norms.asDiagonal() * A;
+        A.makeCompressed();
+        Acol = A;
+        b = b.cwiseProduct(row_norms);
+
+    }
+
+    void compute_reflection(Point &v, const Point &p, const int facet) {
+
+        Eigen::Map<VT> vmap(v.data(), _d);
+        if (transformed) {
+            VT a = row_of(facet);
+            vmap -= (2.0 * vmap.dot(a)) * a;
+            return;
+        }
+        NT dot = NT(0);
+        for (typename SpMT::InnerIterator it(A, facet); it; ++it) dot += it.value() * vmap(it.col());
+        for (typename SpMT::InnerIterator it(A, facet); it; ++it) vmap(it.col()) -= 2.0 * dot * it.value();
+
+    }
+
+    void free_them_all() {}
+
+private:
+
+    // the chord of the ray r + lambda*v given A*T*r and A*T*v; if pos then return the facet hit by the positive ray
+    std::pair<NT,NT> ray_facet(const std::vector<NT> &Ar, const std::vector<NT> &Av, const bool &pos) const {
+
+        NT lamda, min_plus = NT(maxNT), max_minus = NT(minNT);
+        int m = num_of_hyperplanes(), facet;
+
+        for (int i = 0; i < m; i++) {
+            if (Av[i] == NT(0)) continue;
+            lamda = (b(i) - Ar[i]) / Av[i];
+            if (lamda < min_plus && lamda > 0) {
+                min_plus = lamda;
+                if (pos) facet = i;
+            }else if (lamda > max_minus && lamda < 0) max_minus = lamda;
+        }
+        if (pos) return std::pair<NT, NT>(min_plus, facet);
+        return std::pair<NT, NT>(min_plus, max_minus);
+    }
+
+};
+
+#endif
@@ -0,0 +1,110 @@
+// VolEsti (volume computation and sampling library)
+
+// Copyright (c) 20012-2019 Vissarion Fisikopoulos
+// Copyright (c) 2018-2019 Apostolos Chalkis
+
+// Licensed under GNU LGPL.3, see LICENCE file
+
+#ifndef THREAD_WORKSPACES_H
+#define THREAD_WORKSPACES_H
+
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <atomic>
+
+// The mutable state of the oracles of a convex body (LP models, scratch buffers, caches), one
+// Workspace per thread that queries the body. A workspace is default constructed at the first call
+// of local() from a thread and is destroyed with the body or by clear(). Copies of the body do not
+// share workspaces, so many threads can query the same body and copies are released independently.
+//
+// local() looks the workspace up in a small thread_local cache and takes the lock only on a miss,
+// i.e. the first query of a thread or when a thread alternates among more bodies than the cache holds.
+// The cache is keyed by a number that is never reused, so a destroyed body is never found in it.
+// clear() must not run concurrently with queries to the same body.
+template <typename Workspace>
+class ThreadWorkspaces {
+    struct Slot {
+        std::thread::id id;
+        std::unique_ptr<Workspace> ws;
+    };
+
+    struct CacheEntry {
+        unsigned long key;
+        Workspace *ws;
+    };
+    static const unsigned int cache_size = 4;
+
+    std::mutex mtx;
+    std::vector<Slot> slots;
+    unsigned long key;
+
+    static unsigned long new_key() {
+        static std::atomic<unsigned long> next(1);
+        return next++;
+    }
+
+    static CacheEntry* cache() {
+        static thread_local CacheEntry entries[cache_size] = {};
+        return entries;
+    }
+
+public:
+    ThreadWorkspaces() : key(new_key()) {}
+
+    ThreadWorkspaces(const ThreadWorkspaces &) : key(new_key()) {}
+
+    ThreadWorkspaces& operator=(const ThreadWorkspaces &) {
+        clear();
+        return *this;
+    }
+
+    // the workspace of the calling thread
+    Workspace& local() {
+        CacheEntry *entries = cache();
+        for (unsigned int i = 0; i < cache_size; ++i) {
+            if (entries[i].key == key) return *entries[i].ws;
+        }
+
+        Workspace *ws = NULL;
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            std::thread::id id = std::this_thread::get_id();
+            for (unsigned int i = 0; i < slots.size(); ++i) {
+                if (slots[i].id == id) ws = slots[i].ws.get();
+            }
+            if (ws == NULL) {
+                slots.push_back(Slot());
+                slots.back().id = id;
+                slots.back().ws.reset(new Workspace());
+                ws = slots.back().ws.get();
+            }
+        }
+        for (unsigned int i = cache_size - 1; i > 0; --i) entries[i] = entries[i - 1];
+        entries[0].key = key;
+        entries[0].ws = ws;
+        return *ws;
+    }
+
+    // apply f to the workspace of every thread; no thread may query the body concurrently
+    template <typename Function>
+    void for_each(Function f) {
+        std::lock_guard<std::mutex> lock(mtx);
+        for (unsigned int i = 0; i < slots.size(); ++i) f(*slots[i].ws);
+    }
+
+    unsigned int size() {
+        std::lock_guard<std::mutex> lock(mtx);
+        return slots.size();
+    }
+
+    // destroy the workspaces of all the threads, e.g. when the body changes
+    void clear() {
+        std::lock_guard<std::mutex> lock(mtx);
+        slots.clear();
+        key = new_key();
+    }
+};
+
+#endif
@@ -13,6 +13,7 @@
 #include <iostream>
 #include <iterator>
 #include <vector>
+#include <chrono>
 
 template <typename VPolytope>
 class IntersectionOfVpoly {
@@ -27,18 +28,31 @@ public:
     NT rad;
     VPolytope P1;
     VPolytope P2;
+    // generator for the random objectives of the LPs in is_feasible() and ComputeInnerBall()
+    RNGType rng;
 
-    IntersectionOfVpoly() {}
+    IntersectionOfVpoly() : rng(std::chrono::system_clock::now().time_since_epoch().count()) {}
 
-    IntersectionOfVpoly(VPolytope &P, VPolytope &Q) : P1(P), P2(Q) {};
+    IntersectionOfVpoly(VPolytope &P, VPolytope &Q) : P1(P), P2(Q),
+                                                      rng(std::chrono::system_clock::now().time_since_epoch().count()) {};
+
+    void set_seed(const unsigned &seed) {
+        rng.seed(seed);
+    }
 
     VPolytope first() { return P1; }
     VPolytope second() { return P2; }
 
+    // the cheap tests of both polytopes run before any LP, so a point rejected by the tests of P2
+    // costs no LP on P1
     int is_in(const Point &p){
-        if(P1.is_in(p)==-1)
-            return P2.is_in(p);
-        return 0;
+        int res1 = P1.is_in_prefilter(p);
+        if (res1 == 0) return 0;
+        int res2 = P2.is_in_prefilter(p);
+        if (res2 == 0) return 0;
+        if (res1 == 1 && P1.is_in_lp(p) == 0) return 0;
+        if (res2 == 1) return P2.is_in_lp(p);
+        return -1;
     }
 
     void init(const VPolytope &P, const VPolytope &Q) {
@@ -92,7 +106,32 @@ public:
         return 0.0;
     }
 
+    // the support function h(u) = max {u^T x : x in P1 and P2} and a point that attains it, by the LP of
+    // PointInIntersection with the objective u^T V1^T lambda1. Return infinity if the intersection is empty
+    std::pair<Point,NT> support(const Point &u) const {
+        MT V1 = P1.get_mat(), V2 = P2.get_mat();
+        int k1 = V1.rows(), k2 = V2.rows();
+        VT c(k1 + k2);
+        c.head(k1) = V1 * u.map();
+        c.tail(k2).setZero();
+        Point direction(c), p;
+        bool empty;
+#ifdef VOLESTI_LPSOLVE_ORACLES
+        p = PointInIntersection<VT>(V1, V2, direction, empty);
+#else
+        DenseLP<NT> lp;
+        PointInIntersection_model(V1, V2, lp);
+        p = PointInIntersection<VT>(lp, V1, direction, empty);
+#endif
+        if (empty) return std::pair<Point,NT>(p, std::numeric_limits<NT>::infinity());
+        return std::pair<Point,NT>(p, u.dot(p));
+    }
+
+    // estimate the diameter from support queries, see approx_diameter(); if the LPs fail, use
+    // 2 sqrt(d) times the radius cheb_rad of the inscribed ball
     void comp_diam(NT &diam, const NT &cheb_rad) const {
+        approx_diameter<Point>(*this, diam);
+        if (diam > NT(0)) return;
         diam = 2.0 * std::sqrt(NT(dimension())) * cheb_rad;
     }
 
@@ -103,8 +142,14 @@ public:
 
     bool is_feasible() {
         bool empty;
-        PointInIntersection<VT>(P1.get_mat(), P2.get_mat(),
-                                get_direction<RNGType, Point, NT>(P1.get_mat().rows() + P2.get_mat().rows()), empty);
+        Point direction = get_direction<RNGType, Point, NT>(P1.get_mat().rows() + P2.get_mat().rows(), rng);
+#ifdef VOLESTI_LPSOLVE_ORACLES
+        PointInIntersection<VT>(P1.get_mat(), P2.get_mat(), direction, empty);
+#else
+        DenseLP<NT> lp;
+        PointInIntersection_model(P1.get_mat(), P2.get_mat(), lp);
+        PointInIntersection<VT>(lp, P1.get_mat(), direction, empty);
+#endif
         return !empty;
     }
 
@@ -118,11 +163,20 @@ public:
         std::vector<Point> vertices;
         typename std::vector<Point>::iterator rvert;
         bool same;
+#ifndef VOLESTI_LPSOLVE_ORACLES
+        // only the objective changes between the LPs, so each one starts from the previous optimal basis
+        DenseLP<NT> lp;
+        PointInIntersection_model(V1, V2, lp);
+#endif
 
         while(num<d+1){
 
-            direction = get_direction<RNGType, Point, NT>(k);
+            direction = get_direction<RNGType, Point, NT>(k, rng);
+#ifdef VOLESTI_LPSOLVE_ORACLES
             p = PointInIntersection<VT>(V1, V2, direction, same);
+#else
+            p = PointInIntersection<VT>(lp, V1, direction, same);
+#endif
 
             same = false;
             rvert = vertices.begin();
@@ -199,12 +253,18 @@ public:
 
     // compute intersection point of ray starting from r and pointing to v
     // with the V-polytope
+    // the chord of P1 is clipped by P2: an endpoint that the cheap tests of P2 place in P2 is an
+    // endpoint of the intersection, otherwise a one-sided ray-shooting LP on P2 computes it
     std::pair<NT,NT> line_intersect(const Point &r, const Point &v) {
 
-        std::pair <NT, NT> P1pair = P1.line_intersect(r, v);
-        std::pair <NT, NT> P2pair = P2.line_intersect(r, v);
-        return std::pair<NT, NT>(std::min(P1pair.first, P2pair.first),
-                                 std::max(P1pair.second, P2pair.second));
+        std::pair <NT, NT> res = P1.line_intersect(r, v);
+        if (P2.is_in_prefilter(r + res.first * v) != -1) {
+            res.first = std::min(res.first, P2.line_positive_intersect(r, v).first);
+        }
+        if (P2.is_in_prefilter(r + res.second * v) != -1) {
+            res.second = std::max(res.second, -P2.line_positive_intersect(r, -1.0 * v).first);
+        }
+        return res;
 
     }
 
@@ -223,9 +283,14 @@ public:
         return line_intersect(r, v);
     }
 
+    // the second facet is 1 if the ray leaves the intersection through P1 and 2 if through P2.
+    // P2 is not queried when its cheap tests place the exit point of P1 in P2
     std::pair<NT, int> line_positive_intersect(const Point &r, const Point &v) {
 
         std::pair<NT, int> P1pair = P1.line_positive_intersect(r, v);
+        if (P2.is_in_prefilter(r + P1pair.first * v) == -1) {
+            return std::pair<NT, int>(P1pair.first, 1);
+        }
         std::pair<NT, int> P2pair = P2.line_positive_intersect(r, v);
 
         if(P1pair.first < P2pair.first) {
@@ -251,10 +316,9 @@ public:
     std::pair<NT,NT> line_intersect_coord(const Point &r,
                                           const unsigned int &rand_coord,
                                           const std::vector<NT> &lamdas) {
-        std::pair <NT, NT> P1pair = P1.line_intersect_coord(r, rand_coord, lamdas);
-        std::pair <NT, NT> P2pair = P2.line_intersect_coord(r, rand_coord, lamdas);
-        return std::pair<NT, NT>(std::min(P1pair.first, P2pair.first),
-                                 std::max(P1pair.second, P2pair.second));
+        Point v(dimension());
+        v.set_coord(rand_coord, 1.0);
+        return line_intersect(r, v);
     }
 
 
@@ -314,7 +378,7 @@ public:
         if (facet == 1) {
             P1.compute_reflection (v, p, facet);
         } else {
-            P1.compute_reflection (v, p, facet);
+            P2.compute_reflection (v, p, facet);
         }
 
     }
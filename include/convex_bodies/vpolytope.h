@@ -15,6 +15,12 @@
 #include <iostream>
 #include "vpolyoracles.h"
 #include "khach.h"
+#include "point_store.h"
+#include "membership_filter.h"
+#include "facet_cache.h"
+#include "extreme_points.h"
+#include "thread_workspaces.h"
+#include "diameter.h"
 
 //min and max values for the Hit and Run functions
 
@@ -32,11 +38,88 @@ private:
     MT V;  //matrix V. Each row contains a vertex
     VT b;  // vector b that contains first column of ine file
     unsigned int _d;  //dimension
-    REAL *conv_comb, *row, *conv_comb2, *conv_mem;
-    int *colno, *colno_mem;
+    // The state of the oracles of one thread, built from V at its first query: the LPs, solved by DenseLP
+    // or by lp_solve if VOLESTI_LPSOLVE_ORACLES is defined, the cheap accept/reject tests in front of the
+    // membership LP, the facets hit by the billiard walk and the cached facet of the last
+    // line_positive_intersect(), or -1
+    struct Workspace {
+        bool ready;
+#ifdef VOLESTI_LPSOLVE_ORACLES
+        lp_model mem_lp, ray_lp;
+        std::vector<REAL> conv_comb, row, conv_mem;
+        std::vector<int> colno, colno_mem;
+#else
+        DenseLP<NT> mem_lp, ray_lp;
+#endif
+        MembershipFilter<Point> filter;
+        FacetCache<Point> facets;
+        int hit_facet;
+
+        Workspace() : ready(false), hit_facet(-1) {}
+    };
+    ThreadWorkspaces<Workspace> workspaces;
+    int facet_cache_capacity;  // -1 for the default capacity of FacetCache
+
+    // the workspace of the calling thread, with its LPs built
+    Workspace& local() {
+        Workspace &ws = workspaces.local();
+        if (!ws.ready) init_lp_models(ws);
+        return ws;
+    }
+
+    void init_lp_models(Workspace &ws) {
+#ifdef VOLESTI_LPSOLVE_ORACLES
+        int k = V.rows();
+        ws.conv_comb.resize(k + 1);
+        ws.row.resize(k + 1);
+        ws.colno.resize(k + 1);
+        ws.conv_mem.resize(k);
+        ws.colno_mem.resize(k);
+        ws.mem_lp = memLP_Vpoly_model(V, ws.row.data(), ws.colno.data());
+        ws.ray_lp = ray_Vpoly_model(V, ws.row.data(), ws.colno.data(), false);
+#else
+        memLP_Vpoly_model(V, ws.mem_lp);
+        ray_Vpoly_model(V, ws.ray_lp, false);
+#endif
+        ws.ready = true;
+
+        ws.filter.init_vpolytope(V);
+        Point c = ws.filter.center();
+        std::pair<NT,NT> res;
+        for (unsigned int i = 0; i < _d; ++i) {
+            res = line_intersect(c, ws.filter.axis(i));
+            ws.filter.set_inner_axis(i, res.first, -res.second);
+        }
+        ws.filter.set_ready();
+        ws.facets.init(_d);
+        if (facet_cache_capacity >= 0) ws.facets.set_capacity(facet_cache_capacity);
+        ws.hit_facet = -1;
+    }
+
+    // cache the facet of the last point computed by the ray-shooting LP from the interior point r,
+    // if the point lies in the relative interior of a simplex of d vertices
+    int learn_facet(Workspace &ws, const Point &r) {
+        std::vector<int> idx;
+        for (int j = 0; j < num_of_vertices(); ++j) {
+            if (hit_conv_comb(ws, j) > 0.0) idx.push_back(j);
+        }
+        int facet = ws.facets.add(V, idx, r);
+        if (facet >= 0) ws.filter.add_halfspace(ws.facets.normal(facet), ws.facets.offset(facet));
+        return facet;
+    }
+
+    // the coefficient of the j-th vertex in the convex combination of the last point computed by
+    // line_positive_intersect()
+    NT hit_conv_comb(const Workspace &ws, const int j) const {
+#ifdef VOLESTI_LPSOLVE_ORACLES
+        return ws.conv_comb[j];
+#else
+        return ws.ray_lp.solution(j);
+#endif
+    }
 
 public:
-    VPolytope() {}
+    VPolytope() : facet_cache_capacity(-1) {}
 
     // return dimension
     unsigned int dimension() const {
@@ -78,6 +161,7 @@ public:
     // change the matrix V
     void set_mat(const MT &V2) {
         V = V2;
+        workspaces.clear();
     }
 
 
@@ -102,6 +186,7 @@ public:
     // set a specific coeff of matrix V
     void put_mat_coeff(const unsigned int &i, const unsigned int &j, const NT &value) {
         V(i,j) = value;
+        workspaces.clear();
     }
 
 
@@ -114,16 +199,13 @@ public:
         return V;
     }
 
-    void init(const unsigned int &dim, const MT &_V, const VT &_b) {
+    // if remove_redundant is true keep only the vertices of the convex hull of the rows of _V
+    void init(const unsigned int &dim, const MT &_V, const VT &_b, const bool remove_redundant = false) {
         _d = dim;
         V = _V;
         b = _b;
-        conv_comb = (REAL *) malloc((V.rows()+1) * sizeof(*conv_comb));
-        conv_comb2 = (REAL *) malloc((V.rows()+1) * sizeof(*conv_comb2));
-        conv_mem = (REAL *) malloc(V.rows() * sizeof(*conv_mem));
-        colno = (int *) malloc((V.rows()+1) * sizeof(*colno));
-        colno_mem = (int *) malloc(V.rows() * sizeof(*colno_mem));
-        row = (REAL *) malloc((V.rows()+1) * sizeof(*row));
+        if (remove_redundant) remove_redundant_vertices();
+        workspaces.clear();
     }
 
 
@@ -138,12 +220,31 @@ public:
                 V(i - 1, j - 1) = Pin[i][j];
             }
         }
-        conv_comb = (REAL *) malloc(Pin.size() * sizeof(*conv_comb));
-        conv_comb2 = (REAL *) malloc(Pin.size() * sizeof(*conv_comb2));
-        colno = (int *) malloc((V.rows()+1) * sizeof(*colno));
-        colno_mem = (int *) malloc(V.rows() * sizeof(*colno_mem));
-        conv_mem = (REAL *) malloc(V.rows() * sizeof(*conv_mem));
-        row = (REAL *) malloc((V.rows()+1) * sizeof(*row));
+        workspaces.clear();
+    }
+
+
+    // remove the rows of V that are not vertices of their convex hull, e.g. the interior points of
+    // a point cloud; all the oracles then solve smaller LPs. The LPs are split among n_threads threads.
+    // Return the number of the removed rows
+    int remove_redundant_vertices(const unsigned int n_threads = 1) {
+        std::vector<int> vertices = extreme_points(V, n_threads);
+        int removed = V.rows() - vertices.size();
+        if (removed == 0) return 0;
+
+        MT V2(vertices.size(), _d);
+        VT b2(vertices.size());
+        for (unsigned int i = 0; i < vertices.size(); ++i) {
+            V2.row(i) = V.row(vertices[i]);
+            b2(i) = b(vertices[i]);
+        }
+        V = V2;
+        b = b2;
+        workspaces.clear();
+#ifdef VOLESTI_DEBUG
+        std::cout << "removed " << removed << " redundant vertices, " << V.rows() << " vertices left" << std::endl;
+#endif
+        return removed;
     }
 
 
@@ -189,18 +290,17 @@ public:
         return rad;
     }
 
-    void comp_diam(NT &diam, const NT &cheb_rad) {
-        diam = 0.0;
-        NT diam_iter;
-        for (int i = 0; i < num_of_vertices(); ++i) {
-            for (int j = 0; j < num_of_vertices(); ++j) {
-                if(i != j) {
-                    diam_iter = (V.row(i) - V.row(j)).norm();
-                    if (diam_iter > diam) diam = diam_iter;
-                }
-            }
-        }
+    // the support function h(u) = max {u^T x : x in P} and the vertex that attains it
+    std::pair<Point,NT> support(const Point &u) const {
+        int i;
+        NT h = (V * u.map()).maxCoeff(&i);
+        return std::pair<Point,NT>(Point(VT(V.row(i).transpose())), h);
+    }
 
+    // estimate the diameter from support queries, see approx_diameter(); O(kd^2) instead of
+    // the O(k^2 d) of all the pairs of vertices
+    void comp_diam(NT &diam, const NT &cheb_rad) {
+        approx_diameter<Point>(*this, diam);
     }
 
     void normalize() {}
@@ -297,18 +397,12 @@ public:
         Point center(_d);
 
 
-        std::list<Point> randPoints;
+        PointStore<Point> randPoints(_d);
         get_points_for_rounding(randPoints);
 
         boost::numeric::ublas::matrix<double> Ap(_d,randPoints.size());
-        typename std::list<Point>::iterator rpit=randPoints.begin();
-        typename std::vector<NT>::iterator qit;
-        unsigned int i, j = 0;
-        for ( ; rpit!=randPoints.end(); rpit++, j++) {
-            qit = (*rpit).iter_begin(); i=0;
-            for ( ; qit!=(*rpit).iter_end(); qit++, i++){
-                Ap(i,j)=double(*qit);
-            }
+        for (unsigned int j = 0; j < randPoints.size(); ++j) {
+            for (unsigned int i = 0; i < _d; ++i) Ap(i,j) = double(randPoints.col(j)(i));
         }
         boost::numeric::ublas::matrix<double> Q(_d, _d);
         boost::numeric::ublas::vector<double> c2(_d);
@@ -323,7 +417,7 @@ public:
             temp.assign(_d,0);
             temp[i] = 1.0;
             Point v(_d,temp.begin(), temp.end());
-            res = intersect_double_line_Vpoly<NT>(V, center, v, row, colno);
+            res = line_intersect(center, v);
             min_plus = std::min(res.first, -1.0*res.second);
             if (min_plus < radius) radius = min_plus;
         }
@@ -335,9 +429,35 @@ public:
 
     // check if point p belongs to the convex hull of V-Polytope P
     int is_in(const Point &p) {
-        if(memLP_Vpoly(V, p, conv_mem, colno_mem)){
+        int res = is_in_prefilter(p);
+        if (res != 1) return res;
+        return is_in_lp(p);
+    }
+
+
+    // the cheap tests of is_in(): return -1 if p is in the polytope, 0 if it is not and 1 if they
+    // cannot decide
+    int is_in_prefilter(const Point &p) {
+        return local().filter.test(p);
+    }
+
+
+    // the membership LP of is_in(), without the cheap tests
+    int is_in_lp(const Point &p) {
+        Workspace &ws = local();
+#ifdef VOLESTI_LPSOLVE_ORACLES
+        if(memLP_Vpoly(ws.mem_lp.get(), p, ws.conv_mem.data(), ws.colno_mem.data())){
+#else
+        if(memLP_Vpoly(ws.mem_lp, p)){
+#endif
             return -1;
         }
+#ifndef VOLESTI_LPSOLVE_ORACLES
+        // keep the separating halfspace of the LP to reject the next points near p without an LP
+        VT a;
+        NT beta;
+        if (separating_halfspace_Vpoly(ws.mem_lp, V, p, a, beta)) ws.filter.add_halfspace(a, beta);
+#endif
         return 0;
     }
 
@@ -345,8 +465,12 @@ public:
     // compute intersection point of ray starting from r and pointing to v
     // with the V-polytope
     std::pair<NT,NT> line_intersect(const Point &r, const Point &v) {
-
-        return intersect_double_line_Vpoly<NT>(V, r, v, row, colno);
+        Workspace &ws = local();
+#ifdef VOLESTI_LPSOLVE_ORACLES
+        return intersect_double_line_Vpoly(ws.ray_lp.get(), r, v, ws.row.data(), ws.colno.data());
+#else
+        return intersect_double_line_Vpoly(ws.ray_lp, r, v);
+#endif
     }
 
 
@@ -354,21 +478,30 @@ public:
     // with the V-polytope
     std::pair<NT,NT> line_intersect(const Point &r, const Point &v, const std::vector<NT> &Ar,
             const std::vector<NT> &Av) {
-
-        return intersect_double_line_Vpoly<NT>(V, r, v,  row, colno);
+        return line_intersect(r, v);
     }
 
     // compute intersection point of ray starting from r and pointing to v
     // with the V-polytope
     std::pair<NT,NT> line_intersect(const Point &r, const Point &v, const std::vector<NT> &Ar,
                                     const std::vector<NT> &Av, const NT &lambda_prev) {
-
-        return intersect_double_line_Vpoly<NT>(V, r, v,  row, colno);
+        return line_intersect(r, v);
     }
 
 
+    // the cached facets are tried first and the LP runs only if none of them certifies the exit point
     std::pair<NT, int> line_positive_intersect(const Point &r, const Point &v){
-        return std::pair<NT, int> (intersect_line_Vpoly(V, r, v, conv_comb, row, colno, false, false), 1);
+        Workspace &ws = local();
+        NT lambda;
+        ws.hit_facet = ws.facets.intersect(r, v, lambda);
+        if (ws.hit_facet >= 0) return std::pair<NT, int> (lambda, 1);
+#ifdef VOLESTI_LPSOLVE_ORACLES
+        lambda = intersect_line_Vpoly(ws.ray_lp.get(), r, v, ws.conv_comb.data(), ws.row.data(), ws.colno.data(), false);
+#else
+        lambda = intersect_line_Vpoly(ws.ray_lp, r, v, false);
+#endif
+        ws.hit_facet = learn_facet(ws, r);
+        return std::pair<NT, int> (lambda, 1);
     }
 
     std::pair<NT, int> line_positive_intersect(const Point &r, const Point &v, const std::vector<NT> &Ar,
@@ -392,7 +525,7 @@ public:
         std::vector<NT> temp(_d);
         temp[rand_coord]=1.0;
         Point v(_d,temp.begin(), temp.end());
-        return intersect_double_line_Vpoly<NT>(V, r, v,  row, colno);
+        return line_intersect(r, v);
     }
 
 
@@ -411,6 +544,7 @@ public:
     void shift(const VT &c) {
         MT V2 = V.transpose().colwise() - c;
         V = V2.transpose();
+        workspaces.clear();
     }
 
 
@@ -418,6 +552,7 @@ public:
     void linear_transformIt(const MT &T) {
         MT V2 = T.inverse() * V.transpose();
         V = V2.transpose();
+        workspaces.clear();
     }
 
 
@@ -453,10 +588,16 @@ public:
 
     void compute_reflection(Point &v, const Point &p, const int &facet) {
 
+        Workspace &ws = local();
+        if (ws.hit_facet >= 0) {
+            v.map() -= (2.0 * v.map().dot(ws.facets.normal(ws.hit_facet))) * ws.facets.normal(ws.hit_facet);
+            return;
+        }
+
         int count = 0, outvert;
         MT Fmat2(_d,_d);
         for (int j = 0; j < num_of_vertices(); ++j) {
-            if (*(conv_comb + j) > 0.0) {
+            if (hit_conv_comb(ws, j) > 0.0) {
                 Fmat2.row(count) = V.row(j);
                 count++;
             } else {
@@ -474,13 +615,35 @@ public:
         v = s + v;
     }
 
+    // the counters of the membership filter of the calling thread
+    const MembershipFilter<Point>& get_membership_filter() {
+        return local().filter;
+    }
+
+    const FacetCache<Point>& get_facet_cache() {
+        return local().facets;
+    }
+
+    // the maximum number of facets cached for the billiard walk, in the workspace of every thread
+    void set_facet_cache_capacity(const unsigned int capacity) {
+        facet_cache_capacity = capacity;
+        workspaces.for_each([&](Workspace &ws) {
+            ws.facets.set_capacity(capacity);
+            ws.hit_facet = -1;
+        });
+    }
+
+    // release the oracles of all the threads; they are built again at the next query
     void free_them_all() {
-        free(row);
-        free(colno);
-        free(conv_comb);
-        free(colno_mem);
-        free(conv_comb2);
-        free(conv_mem);
+#ifdef VOLESTI_DEBUG
+        workspaces.for_each([](Workspace &ws) {
+            if (!ws.ready) return;
+            ws.filter.print_stats();
+            std::cout << "billiard ray-shooting queries = " << ws.facets.num_of_queries()
+                      << ", certified by cached facets = " << ws.facets.num_of_hits() << std::endl;
+        });
+#endif
+        workspaces.clear();
     }
 
 };
@@ -6,6 +6,8 @@
 #ifndef ZONOINTERSECTHPOLY_H
 #define ZONOINTERSECTHPOLY_H
 
+#include "diameter.h"
+
 
 template <typename Zonotope, typename HPolytope>
 class ZonoIntersectHPoly {
@@ -55,6 +57,31 @@ public:
         return HP.get_vec();
     }
 
+    // the support function h(u) = max {u^T x : x in Z and HP} and a point that attains it, by the LP
+    // max {(V u)^T lambda : A V^T lambda <= b, -1 <= lambda <= 1} over the coefficients of the k generators
+    // (the rows of V), with m slack columns. Return infinity if the intersection is empty
+    std::pair<Point,NT> support(const Point &u) const {
+        MT V = Z.get_mat(), A = HP.get_mat();
+        int k = V.rows(), m = A.rows();
+        DenseLP<NT> lp(m, k + m);
+        lp.A.leftCols(k) = A * V.transpose();
+        lp.A.rightCols(m).setIdentity();
+        lp.b = HP.get_vec();
+        lp.c.head(k) = V * u.map();
+        lp.l.head(k).setConstant(NT(-1));
+        lp.u.head(k).setOnes();
+        if (lp.solve() != DenseLP<NT>::LP_OPTIMAL) {
+            return std::pair<Point,NT>(Point(dimension()), std::numeric_limits<NT>::infinity());
+        }
+        VT x = V.transpose() * lp.solution().head(k);
+        return std::pair<Point,NT>(Point(x), lp.objective());
+    }
+
+    // estimate the diameter from support queries, see approx_diameter()
+    void comp_diam(NT &diam, const NT &cheb_rad) const {
+        approx_diameter<Point>(*this, diam);
+    }
+
     std::pair<NT,NT> line_intersect(Point &r, Point &v) {
 
         std::pair <NT, NT> polypair = HP.line_intersect(r, v);
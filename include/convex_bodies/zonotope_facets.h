@@ -0,0 +1,147 @@
+// VolEsti (volume computation and sampling library)
+
+// Copyright (c) 20012-2019 Vissarion Fisikopoulos
+// Copyright (c) 2018-2019 Apostolos Chalkis
+
+// Licensed under GNU LGPL.3, see LICENCE file
+
+#ifndef ZONOTOPE_FACETS_H
+#define ZONOTOPE_FACETS_H
+
+#include <vector>
+#include <algorithm>
+#include <thread>
+#include "zpolytope.h"
+
+// The facets of a zonotope Z = {V^T lambda, lambda in [-1,1]^k} with generators the rows of V.
+// Every facet of Z is parallel to d-1 linearly independent generators, so its normal a is the normal of
+// the hyperplane they span and its offset is the support function h(a) = sum_i |a^T v_i|. Z has at most
+// 2*C(k,d-1) facets, fewer when more than d-1 generators lie in a hyperplane.
+
+
+// the number of r-subsets of k elements, or limit+1 if it is larger than limit
+inline unsigned long num_of_subsets(const unsigned int k, const unsigned int r, const unsigned long limit) {
+    unsigned long num = 1;
+    for (unsigned int i = 1; i <= r; ++i) {
+        // num * (k - r + i) / i is C(k - r + i, i), an integer
+        num = num * (k - r + i) / i;
+        if (num > limit) return limit + 1;
+    }
+    return num;
+}
+
+
+// compute the H-representation A x <= b of the zonotope with generators the rows of V, if it has
+// at most max_facets facets. The normals of the (d-1)-subsets of generators are computed by n_threads threads.
+// Return false if Z is not full dimensional or 2*C(k,d-1) > max_facets
+template <typename MT, typename VT>
+bool zonotope_facets(const MT &V, MT &A, VT &b, const unsigned long max_facets, const unsigned int n_threads = 1) {
+
+    typedef typename MT::Scalar NT;
+    const unsigned int k = V.rows(), d = V.cols();
+
+    if (d == 0 || k < d || 2 * num_of_subsets(k, d - 1, max_facets / 2) > max_facets) return false;
+    if (Eigen::FullPivLU<MT>(V).rank() < int(d)) return false;
+
+    // all the (d-1)-subsets of the generators
+    std::vector<std::vector<int> > subsets;
+    std::vector<bool> bitmask(k, false);
+    std::fill(bitmask.begin(), bitmask.begin() + (d - 1), true);
+    do {
+        std::vector<int> subset;
+        for (unsigned int i = 0; i < k; ++i) {
+            if (bitmask[i]) subset.push_back(i);
+        }
+        subsets.push_back(subset);
+    } while (std::prev_permutation(bitmask.begin(), bitmask.end()));
+
+    const unsigned int num = subsets.size();
+    MT normals(d, num);
+    std::vector<char> valid(num, 0);
+
+    // the normal of the hyperplane spanned by each subset, with its first nonzero coordinate positive
+    auto compute_normals = [&](const unsigned int t, const unsigned int step) {
+        MT M(d - 1, d);
+        VT a(d);
+        for (unsigned int s = t; s < num; s += step) {
+            if (d == 1) {
+                a(0) = NT(1);
+            } else {
+                for (unsigned int j = 0; j < d - 1; ++j) M.row(j) = V.row(subsets[s][j]);
+                Eigen::FullPivLU<MT> lu(M);
+                if (lu.rank() < int(d) - 1) continue;
+                a = lu.kernel().col(0);
+                a.normalize();
+            }
+            for (unsigned int i = 0; i < d; ++i) {
+                if (std::abs(a(i)) > NT(1e-12)) {
+                    if (a(i) < NT(0)) a = -a;
+                    break;
+                }
+            }
+            normals.col(s) = a;
+            valid[s] = 1;
+        }
+    };
+
+    const unsigned int threads = std::max(1u, std::min(n_threads, num));
+    if (threads == 1) {
+        compute_normals(0, 1);
+    } else {
+        std::vector<std::thread> workers;
+        for (unsigned int t = 0; t < threads; t++) workers.push_back(std::thread(compute_normals, t, threads));
+        for (unsigned int t = 0; t < threads; t++) workers[t].join();
+    }
+
+    // remove the normals of the subsets that span the same hyperplane
+    std::vector<int> order;
+    for (unsigned int s = 0; s < num; ++s) {
+        if (valid[s]) order.push_back(s);
+    }
+    std::sort(order.begin(), order.end(), [&](const int s1, const int s2) {
+        for (unsigned int i = 0; i < d; ++i) {
+            if (normals(i, s1) != normals(i, s2)) return normals(i, s1) < normals(i, s2);
+        }
+        return false;
+    });
+    std::vector<int> facets;
+    for (unsigned int s = 0; s < order.size(); ++s) {
+        if (facets.empty() ||
+            (normals.col(order[s]) - normals.col(facets.back())).template lpNorm<Eigen::Infinity>() > NT(1e-10)) {
+            facets.push_back(order[s]);
+        }
+    }
+
+    A.resize(2 * facets.size(), d);
+    b.resize(2 * facets.size());
+    for (unsigned int i = 0; i < facets.size(); ++i) {
+        VT a = normals.col(facets[i]);
+        NT h = (V * a).cwiseAbs().sum();
+        A.row(2 * i) = a.transpose();
+        A.row(2 * i + 1) = -a.transpose();
+        b(2 * i) = h;
+        b(2 * i + 1) = h;
+    }
+    return true;
+}
+
+
+// only zonotopes are converted to H-polytopes
+template <typename Polytope, typename Hpolytope>
+bool zonotope_as_hpoly(const Polytope &P, Hpolytope &HP, const unsigned int n_threads = 1) {
+    return false;
+}
+
+
+// set HP to the H-representation of the zonotope Z if it has at most Z.get_max_hpoly_facets() facets
+template <typename Point, typename Hpolytope>
+bool zonotope_as_hpoly(const Zonotope<Point> &Z, Hpolytope &HP, const unsigned int n_threads = 1) {
+
+    typename Zonotope<Point>::MT A;
+    typename Zonotope<Point>::VT b;
+    if (!zonotope_facets(Z.get_mat(), A, b, Z.get_max_hpoly_facets(), n_threads)) return false;
+    HP.init(Z.dimension(), A, b);
+    return true;
+}
+
+#endif
@@ -15,6 +15,9 @@
 #include <iostream>
 #include "vpolyoracles.h"
 #include "zpolyoracles.h"
+#include "membership_filter.h"
+#include "thread_workspaces.h"
+#include "diameter.h"
 
 //min and max values for the Hit and Run functions
 
@@ -32,15 +35,72 @@ private:
     unsigned int _d;  //dimension
     NT maxNT = std::numeric_limits<NT>::max();
     NT minNT = std::numeric_limits<NT>::lowest();
-    REAL *conv_comb, *row, *row_mem;
-    int *colno, *colno_mem;
     MT sigma;
     MT Q0;
     MT T;
+    // The state of the oracles of one thread, built from V at its first query: the LPs, solved by DenseLP
+    // or by lp_solve if VOLESTI_LPSOLVE_ORACLES is defined, and the cheap accept/reject tests in front of
+    // the membership LP
+    struct Workspace {
+        bool ready;
+#ifdef VOLESTI_LPSOLVE_ORACLES
+        lp_model mem_lp, ray_lp;
+        std::vector<REAL> conv_comb, row;
+        std::vector<int> colno;
+#else
+        DenseLP<NT> mem_lp, ray_lp;
+#endif
+        MembershipFilter<Point> filter;
+
+        Workspace() : ready(false) {}
+    };
+    ThreadWorkspaces<Workspace> workspaces;
+    // the volume and sampling algorithms use the H-representation if it has at most that many facets
+    unsigned int max_hpoly_facets;
+
+    // the workspace of the calling thread, with its LPs built
+    Workspace& local() {
+        Workspace &ws = workspaces.local();
+        if (!ws.ready) init_lp_models(ws);
+        return ws;
+    }
+
+    void init_lp_models(Workspace &ws) {
+#ifdef VOLESTI_LPSOLVE_ORACLES
+        int k = V.rows();
+        ws.conv_comb.resize(k + 1);
+        ws.row.resize(k + 1);
+        ws.colno.resize(k + 1);
+        ws.mem_lp = memLP_Zonotope_model(V, ws.row.data(), ws.colno.data());
+        ws.ray_lp = ray_Vpoly_model(V, ws.row.data(), ws.colno.data(), true);
+#else
+        memLP_Zonotope_model(V, ws.mem_lp);
+        ray_Vpoly_model(V, ws.ray_lp, true);
+#endif
+        ws.ready = true;
+
+        ws.filter.init_zonotope(V);
+        Point c = ws.filter.center();
+        std::pair<NT,NT> res;
+        for (unsigned int i = 0; i < _d; ++i) {
+            res = line_intersect(c, ws.filter.axis(i));
+            ws.filter.set_inner_axis(i, res.first, -res.second);
+        }
+        ws.filter.set_ready();
+    }
+
+    // the coefficient of the j-th generator of the last point computed by line_positive_intersect()
+    NT hit_conv_comb(const Workspace &ws, const int j) const {
+#ifdef VOLESTI_LPSOLVE_ORACLES
+        return ws.conv_comb[j];
+#else
+        return ws.ray_lp.solution(j);
+#endif
+    }
 
 public:
 
-    Zonotope() {}
+    Zonotope() : max_hpoly_facets(2000) {}
 
     // return the dimension
     unsigned int dimension() const {
@@ -94,6 +154,15 @@ public:
 
     }
 
+    unsigned int get_max_hpoly_facets() const {
+        return max_hpoly_facets;
+    }
+
+    // 0 keeps the LP oracles in any case
+    void set_max_hpoly_facets(const unsigned int max_facets) {
+        max_hpoly_facets = max_facets;
+    }
+
     MT get_T() const {
         return T;
     }
@@ -133,6 +202,7 @@ public:
     // change the matrix V
     void set_mat(const MT &V2) {
         V = V2;
+        workspaces.clear();
     }
 
 
@@ -157,6 +227,7 @@ public:
     // set a specific coeff of matrix V
     void put_mat_coeff(const unsigned int i, const unsigned int j, const NT &value) {
         V(i,j) = value;
+        workspaces.clear();
     }
 
 
@@ -179,12 +250,8 @@ public:
         _d = dim;
         V = _V;
         b = _b;
-        conv_comb = (REAL *) malloc((V.rows()+1) * sizeof(*conv_comb));
-        colno = (int *) malloc((V.rows()+1) * sizeof(*colno));
-        row = (REAL *) malloc((V.rows()+1) * sizeof(*row));
-        colno_mem = (int *) malloc((V.rows()) * sizeof(*colno_mem));
-        row_mem = (REAL *) malloc((V.rows()) * sizeof(*row_mem));
         compute_eigenvectors(V.transpose());
+        workspaces.clear();
     }
 
 
@@ -199,12 +266,8 @@ public:
                 V(i - 1, j - 1) = Pin[i][j];
             }
         }
-        conv_comb = (REAL *) malloc(Pin.size() * sizeof(*conv_comb));
-        colno = (int *) malloc((V.rows()+1) * sizeof(*colno));
-        row = (REAL *) malloc((V.rows()+1) * sizeof(*row));
-        colno_mem = (int *) malloc((V.rows()) * sizeof(*colno_mem));
-        row_mem = (REAL *) malloc((V.rows()) * sizeof(*row_mem));
         compute_eigenvectors(V.transpose());
+        workspaces.clear();
     }
 
 
@@ -228,9 +291,22 @@ public:
 
     // check if point p belongs to the convex hull of V-Polytope P
     int is_in(const Point &p) {
-        if(memLP_Zonotope(V, p, row_mem, colno_mem)){
+        Workspace &ws = local();
+        int res = ws.filter.test(p);
+        if (res != 1) return res;
+#ifdef VOLESTI_LPSOLVE_ORACLES
+        if(memLP_Zonotope(ws.mem_lp.get(), p)){
+#else
+        if(memLP_Zonotope(ws.mem_lp, p)){
+#endif
             return -1;
         }
+#ifndef VOLESTI_LPSOLVE_ORACLES
+        // keep the separating halfspace of the LP to reject the next points near p without an LP
+        VT a;
+        NT beta;
+        if (separating_halfspace_Zonotope(ws.mem_lp, V, p, a, beta)) ws.filter.add_halfspace(a, beta);
+#endif
         return 0;
     }
 
@@ -245,7 +321,7 @@ public:
             temp.assign(_d,0);
             temp[i] = 1.0;
             Point v(_d,temp.begin(), temp.end());
-            min_plus = intersect_line_Vpoly<NT>(V, center, v, conv_comb, row, colno, false, true);
+            min_plus = line_positive_intersect(center, v).first;
             if (min_plus < radius) radius = min_plus;
         }
 
@@ -254,37 +330,28 @@ public:
     }
 
 
-    void comp_diam(NT &diam, const NT &cheb_rad) {
-
-        int k = V.rows(), max_index = -1;
-
-        MT D = V.transpose() * V;
-        D = (D + D.transpose()) / 2.0;
-
-        Eigen::SelfAdjointEigenSolver<MT> es(D);
-        MT D2 = es.eigenvalues().asDiagonal(), Q = es.eigenvectors();
-
-        NT max_eig = 0.0;
-        for (int i = 0; i < _d; ++i) {
-            if (es.eigenvalues()[i] > max_eig) {
-                max_eig = es.eigenvalues()[i];
-                max_index = i;
-            }
-        }
-
-        VT max_eigvec = -1.0*Q.col(max_index);
-        VT obj_fun = max_eigvec.transpose() * V.transpose(), x0(k);
-
-        for (int j = 0; j < k; ++j) x0(j) = (obj_fun(j) < 0.0) ? -1.0 : 1.0;
-
-        diam = 2.0 * (V.transpose() * x0).norm();
+    // the support function h(u) = sum_i |u^T v_i| over the generators v_i and the vertex
+    // sum_i sign(u^T v_i) v_i that attains it
+    std::pair<Point,NT> support(const Point &u) const {
+        VT Vu = V * u.map();
+        VT x = V.transpose() * Vu.cwiseSign();
+        return std::pair<Point,NT>(Point(x), Vu.cwiseAbs().sum());
+    }
 
+    // estimate the diameter from support queries, see approx_diameter()
+    void comp_diam(NT &diam, const NT &cheb_rad) {
+        approx_diameter<Point>(*this, diam);
     }
 
     // compute intersection point of ray starting from r and pointing to v
     // with the Zonotope
     std::pair<NT,NT> line_intersect(const Point &r, const Point &v) {
-        return intersect_line_zono(V, r, v, conv_comb, colno);
+        Workspace &ws = local();
+#ifdef VOLESTI_LPSOLVE_ORACLES
+        return intersect_line_zono(ws.ray_lp.get(), r, v, ws.row.data(), ws.colno.data());
+#else
+        return intersect_line_zono(ws.ray_lp, r, v);
+#endif
     }
 
 
@@ -292,20 +359,30 @@ public:
     // with the Zonotope
     std::pair<NT,NT> line_intersect(const Point &r, const Point &v, const std::vector<NT> &Ar,
             const std::vector<NT> &Av) {
-        return intersect_line_zono(V, r, v, conv_comb, colno);
+        return line_intersect(r, v);
     }
 
     // compute intersection point of ray starting from r and pointing to v
     // with the Zonotope
     std::pair<NT,NT> line_intersect(const Point &r, const Point &v, const std::vector<NT> &Ar,
                                     const std::vector<NT> &Av, const NT &lambda_prev) {
+        return line_intersect(r, v);
+    }
 
-        return intersect_line_zono(V, r, v, conv_comb, colno);
+    std::pair<NT, int> line_positive_intersect(const Point &r, const Point &v) {
+        Workspace &ws = local();
+#ifdef VOLESTI_LPSOLVE_ORACLES
+        return std::pair<NT, int> (intersect_line_Vpoly(ws.ray_lp.get(), r, v, ws.conv_comb.data(), ws.row.data(),
+                                                        ws.colno.data(), false), 1);
+#else
+        return std::pair<NT, int> (intersect_line_Vpoly(ws.ray_lp, r, v, false), 1);
+#endif
     }
 
+
     std::pair<NT, int> line_positive_intersect(const Point &r, const Point &v, const std::vector<NT> &Ar,
                                                const std::vector<NT> &Av) {
-        return std::pair<NT, int> (intersect_line_Vpoly(V, r, v, conv_comb, row, colno, false, true), 1);
+        return line_positive_intersect(r, v);
     }
 
 
@@ -324,8 +401,7 @@ public:
         std::vector<NT> temp(_d,0);
         temp[rand_coord]=1.0;
         Point v(_d,temp.begin(), temp.end());
-
-        return intersect_line_zono(V, r, v, conv_comb, colno);
+        return line_intersect(r, v);
 
     }
 
@@ -360,6 +436,7 @@ public:
     void linear_transformIt(const MT &T) {
         MT V2 = T.inverse() * V.transpose();
         V = V2.transpose();
+        workspaces.clear();
     }
 
     // return false to the rounding function
@@ -373,12 +450,13 @@ public:
 
     void compute_reflection(Point &v, const Point &p, const int &facet) {
 
+        Workspace &ws = local();
         int count = 0;
         MT Fmat(_d-1,_d);
         const NT e = 0.0000000001;
         for (int j = 0; j < num_of_generators(); ++j) {
-            if (((1.0 - *(conv_comb + j) ) > e || (1.0 - *(conv_comb + j) ) > e*std::abs(*(conv_comb + j))) &&
-                ((1.0 + *(conv_comb + j) ) > e || (1.0 + *(conv_comb + j) ) > e*std::abs(*(conv_comb + j)))) {
+            const NT cj = hit_conv_comb(ws, j);
+            if (((1.0 - cj) > e || (1.0 - cj) > e*std::abs(cj)) && ((1.0 + cj) > e || (1.0 + cj) > e*std::abs(cj))) {
                 Fmat.row(count) = V.row(j);
                 count++;
             }
@@ -398,12 +476,19 @@ public:
         v = s + v;
     }
 
+    // the counters of the membership filter of the calling thread
+    const MembershipFilter<Point>& get_membership_filter() {
+        return local().filter;
+    }
+
+    // release the oracles of all the threads; they are built again at the next query
     void free_them_all() {
-        free(row);
-        free(colno);
-        free(conv_comb);
-        free(row_mem);
-        free(colno_mem);
+#ifdef VOLESTI_DEBUG
+        workspaces.for_each([](Workspace &ws) {
+            if (ws.ready) ws.filter.print_stats();
+        });
+#endif
+        workspaces.clear();
     }
 
 };
@@ -33,7 +33,7 @@ Polytope random_hpoly(unsigned int dim, unsigned int m, double seed = std::numer
     unsigned int j;
 
     for(unsigned int i=0; i<m; ++i){
-        p = get_direction<RNGType, Point, NT>(dim);
+        p = get_direction<RNGType, Point, NT>(dim, rng);
         pit = p.iter_begin();
         j = 0;
         for ( ;  pit!=p.iter_end(); ++pit, ++j) {
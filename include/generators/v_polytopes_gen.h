@@ -83,12 +83,6 @@ Polytope random_vpoly_incube(unsigned int d, unsigned int k, double seed = std::
     typedef typename Polytope::NT    NT;
     typedef typename Polytope::PolytopePoint Point;
 
-    REAL *conv_mem;
-    int *colno_mem;
-
-    conv_mem = (REAL *) malloc(k * sizeof(*conv_mem));
-    colno_mem = (int *) malloc(k * sizeof(*colno_mem));
-
     unsigned rng_seed = std::chrono::system_clock::now().time_since_epoch().count();
     RNGType rng(rng_seed);
     if (!std::isnan(seed)) {
@@ -97,7 +91,6 @@ Polytope random_vpoly_incube(unsigned int d, unsigned int k, double seed = std::
     }
     boost::random::uniform_real_distribution<> urdist1(-1, 1);
 
-    Point p(d);
     typename std::vector<NT>::iterator pit;
     MT V(k, d);
     unsigned int j, count_row,it=0;
@@ -128,19 +121,13 @@ Polytope random_vpoly_incube(unsigned int d, unsigned int k, double seed = std::
             }
         }
         indices.clear();
-        V2.resize(k, d);
-        V2 = V;
-
-        for (int i = 0; i < k; ++i) {
-            for (int j = 0; j < d; ++j) {
-                p.set_coord(j, V(i, j));
-            }
-            removeRow(V2, i);
-            if (memLP_Vpoly(V2, p, conv_mem, colno_mem)){
+        std::vector<int> vertices = extreme_points(V);
+        for (int i = 0, l = 0; i < k; ++i) {
+            if (l < vertices.size() && vertices[l] == i) {
+                l++;
+            } else {
                 indices.push_back(i);
             }
-            V2.resize(k, d);
-            V2 = V;
         }
         if (indices.size()==0) {
             VP.init(d, V, b);
@@ -160,8 +147,6 @@ Polytope random_vpoly_incube(unsigned int d, unsigned int k, double seed = std::
     }
 
     VP.init(d, V2, VT::Ones(V2.rows()));
-    free(colno_mem);
-    free(conv_mem);
 
     return VP;
 
@@ -0,0 +1,376 @@
+// VolEsti (volume computation and sampling library)
+
+// Copyright (c) 20012-2019 Vissarion Fisikopoulos
+// Copyright (c) 2018-2019 Apostolos Chalkis
+
+// Licensed under GNU LGPL.3, see LICENCE file
+
+#ifndef DENSE_LP_H
+#define DENSE_LP_H
+
+#include <vector>
+#include <limits>
+#include <cmath>
+#include <algorithm>
+#include "Eigen/Eigen"
+
+
+// A dense bounded-variable primal simplex for small linear programs of the form
+//
+//     max (or min) c^T x   s.t.   A x = b,   l <= x <= u,
+//
+// where A has a few rows and many columns, e.g. the LPs of the V-polytope and zonotope oracles
+// with d+1 rows and one column per vertex or generator. An infinite bound is +/-infinity().
+//
+// The data A, b, c, l, u are public. The caller sets them once and then changes only the data of
+// each query (usually b, c and one column of A) before calling solve(). solve() starts from the
+// optimal basis of the last successful call if it is still primal feasible; otherwise it runs a phase I
+// with one artificial variable per row. The inverse of the basis is kept explicitly (m x m), so a
+// pivot costs O(m^2) and the pricing one product A^T y, i.e. O(mn).
+//
+// All the state of the solver lives in the object. Distinct objects can be used by distinct threads.
+template <typename NT>
+class DenseLP {
+public:
+    typedef Eigen::Matrix<NT, Eigen::Dynamic, Eigen::Dynamic> MT;
+    typedef Eigen::Matrix<NT, Eigen::Dynamic, 1> VT;
+
+    enum Status {LP_OPTIMAL, LP_INFEASIBLE, LP_UNBOUNDED, LP_ITERATION_LIMIT};
+
+    MT A;
+    VT b, c, l, u;
+
+    static NT infinity() {
+        return std::numeric_limits<NT>::infinity();
+    }
+
+    DenseLP() : _m(0), _n(0) {}
+
+    // a problem with m rows and n columns, A = 0, b = 0, c = 0 and bounds [0, infinity)
+    DenseLP(const int m, const int n) {
+        resize(m, n);
+    }
+
+    void resize(const int m, const int n) {
+        _m = m;
+        _n = n;
+        A.setZero(m, n);
+        b.setZero(m);
+        c.setZero(n);
+        l.setZero(n);
+        u.setConstant(n, infinity());
+        warm_basis.clear();
+    }
+
+    int rows() const {
+        return _m;
+    }
+
+    int cols() const {
+        return _n;
+    }
+
+    // forget the basis of the previous solve, the next solve starts with phase I
+    void reset_basis() {
+        warm_basis.clear();
+    }
+
+    // solve the problem; for maximize = false minimize c^T x
+    Status solve(const bool maximize = true) {
+
+        lower.resize(_n + _m);
+        upper.resize(_n + _m);
+        lower.head(_n) = l;
+        upper.head(_n) = u;
+        cost.setZero(_n + _m);
+
+        status = LP_ITERATION_LIMIT;
+        if (!warm_start()) {
+            if (!cold_start()) return status;
+        }
+
+        // phase II: the artificial variables are fixed to zero
+        lower.tail(_m).setZero();
+        upper.tail(_m).setZero();
+        cost.head(_n) = maximize ? c : VT(-c);
+        cost.tail(_m).setZero();
+
+        status = simplex();
+        if (status == LP_OPTIMAL) {
+            warm_basis = basis;
+            warm_state = state;
+            warm_sign = sign;
+        }
+        return status;
+    }
+
+    Status get_status() const {
+        return status;
+    }
+
+    // the value of c^T x at the solution of the last solve
+    NT objective() const {
+        return c.dot(x.head(_n));
+    }
+
+    // the solution of the last solve
+    Eigen::VectorBlock<const VT> solution() const {
+        return x.head(_n);
+    }
+
+    NT solution(const int j) const {
+        return x(j);
+    }
+
+    // after a solve that returned LP_OPTIMAL, the simplex multipliers y with B^T y = c_B of the optimal
+    // basis B, i.e. an optimal dual solution; they are those of -c if the problem was minimized
+    const VT& dual() const {
+        return y;
+    }
+
+    // after a solve that returned LP_INFEASIBLE, a vector z with z^T b > max { z^T A x : l <= x <= u },
+    // i.e. the optimal dual solution of phase I
+    VT infeasibility_certificate() const {
+        return -y;
+    }
+
+private:
+    enum VarState {BASIC, AT_LOWER, AT_UPPER, AT_ZERO};
+
+    int _m, _n;
+    Status status;
+    std::vector<int> basis;   // the basic variable of each row; j >= n is the artificial variable of row j-n
+    std::vector<char> state;  // the state of every variable
+    std::vector<int> warm_basis; // the basis of the last optimal solve and the states of its variables
+    std::vector<char> warm_state;
+    VT warm_sign;
+    VT x, lower, upper, cost; // values, bounds and costs of the n structural and the m artificial variables
+    VT sign;                  // the column of the artificial variable of row i is sign(i) * e_i
+    MT Binv;                  // inverse of the basis matrix
+    VT y, d, alpha, rhs;
+
+    NT tol() const {
+        return NT(1e-9);
+    }
+
+    // alpha = Binv * (column j)
+    void ftran(const int j) {
+        if (j < _n) {
+            alpha.noalias() = Binv * A.col(j);
+        } else {
+            alpha = sign(j - _n) * Binv.col(j - _n);
+        }
+    }
+
+    void set_nonbasic(const int j, const char st) {
+        state[j] = st;
+        x(j) = (st == AT_LOWER) ? lower(j) : (st == AT_UPPER) ? upper(j) : NT(0);
+    }
+
+    // the state of a nonbasic variable at the bound that is finite
+    char default_state(const int j) const {
+        if (lower(j) > -infinity()) return AT_LOWER;
+        if (upper(j) < infinity()) return AT_UPPER;
+        return AT_ZERO;
+    }
+
+    // compute the inverse of the basis and the values of the basic variables from the nonbasic ones
+    bool refactor() {
+        MT B(_m, _m);
+        for (int i = 0; i < _m; ++i) {
+            if (basis[i] < _n) {
+                B.col(i) = A.col(basis[i]);
+            } else {
+                B.col(i).setZero();
+                B(basis[i] - _n, i) = sign(basis[i] - _n);
+            }
+        }
+        Eigen::FullPivLU<MT> lu(B);
+        if (!lu.isInvertible()) return false;
+        Binv = lu.inverse();
+
+        rhs = b;
+        for (int j = 0; j < _n; ++j) {
+            if (state[j] != BASIC && x(j) != NT(0)) rhs -= x(j) * A.col(j);
+        }
+        for (int i = 0; i < _m; ++i) {
+            if (state[_n + i] != BASIC) rhs(i) -= sign(i) * x(_n + i);
+        }
+        rhs = Binv * rhs;
+        for (int i = 0; i < _m; ++i) x(basis[i]) = rhs(i);
+        return true;
+    }
+
+    // start from the basis of the last optimal solve if it is primal feasible for the new data
+    bool warm_start() {
+        if (int(warm_basis.size()) != _m || int(warm_state.size()) != _n + _m) return false;
+        basis = warm_basis;
+        state = warm_state;
+        sign = warm_sign;
+        x.resize(_n + _m);
+
+        lower.tail(_m).setZero();
+        upper.tail(_m).setZero();
+        for (int j = 0; j < _n + _m; ++j) {
+            if (state[j] == BASIC) continue;
+            char st = state[j];
+            if ((st == AT_LOWER && !(lower(j) > -infinity())) || (st == AT_UPPER && !(upper(j) < infinity())) ||
+                (st == AT_ZERO && (lower(j) > -infinity() || upper(j) < infinity()))) {
+                st = default_state(j);
+            }
+            set_nonbasic(j, st);
+        }
+        if (!refactor()) return false;
+
+        for (int i = 0; i < _m; ++i) {
+            const int j = basis[i];
+            if (x(j) < lower(j) - tol() * (NT(1) + std::abs(lower(j))) ||
+                x(j) > upper(j) + tol() * (NT(1) + std::abs(upper(j)))) return false;
+        }
+        return true;
+    }
+
+    // phase I: start from the basis of the artificial variables and minimize their sum
+    bool cold_start() {
+        x.setZero(_n + _m);
+        state.assign(_n + _m, BASIC);
+        for (int j = 0; j < _n; ++j) set_nonbasic(j, default_state(j));
+
+        rhs = b;
+        for (int j = 0; j < _n; ++j) {
+            if (x(j) != NT(0)) rhs -= x(j) * A.col(j);
+        }
+        sign.resize(_m);
+        basis.resize(_m);
+        for (int i = 0; i < _m; ++i) {
+            sign(i) = (rhs(i) >= NT(0)) ? NT(1) : NT(-1);
+            basis[i] = _n + i;
+            x(_n + i) = std::abs(rhs(i));
+        }
+        Binv = sign.asDiagonal();
+
+        lower.tail(_m).setZero();
+        upper.tail(_m).setConstant(infinity());
+        cost.head(_n).setZero();
+        cost.tail(_m).setConstant(NT(-1));
+
+        status = simplex();
+        if (status != LP_OPTIMAL) return false;
+
+        if (x.tail(_m).sum() > tol() * (NT(1) + b.template lpNorm<Eigen::Infinity>()) * NT(_m)) {
+            status = LP_INFEASIBLE;
+            return false;
+        }
+        for (int i = 0; i < _m; ++i) {
+            if (state[_n + i] != BASIC) set_nonbasic(_n + i, AT_LOWER);
+        }
+        return true;
+    }
+
+    // the primal simplex method with the costs in cost, from a primal feasible basis
+    Status simplex() {
+
+        const int max_iter = 50 * (_m + _n), refactor_freq = 50;
+        int degenerate = 0;
+        bool bland = false;
+
+        for (int iter = 0; iter < max_iter; ++iter) {
+
+            if (iter > 0 && iter % refactor_freq == 0 && !refactor()) return LP_ITERATION_LIMIT;
+
+            // pricing
+            for (int i = 0; i < _m; ++i) rhs(i) = cost(basis[i]);
+            y.noalias() = Binv.transpose() * rhs;
+            d.noalias() = cost.head(_n) - A.transpose() * y;
+
+            int q = -1;
+            NT dq = NT(0), best = NT(0);
+            for (int j = 0; j < _n + _m; ++j) {
+                if (state[j] == BASIC || lower(j) == upper(j)) continue;
+                const NT dj = (j < _n) ? d(j) : cost(j) - sign(j - _n) * y(j - _n);
+                if ((state[j] == AT_LOWER && dj > tol()) || (state[j] == AT_UPPER && dj < -tol()) ||
+                    (state[j] == AT_ZERO && std::abs(dj) > tol())) {
+                    if (bland) {
+                        q = j;
+                        dq = dj;
+                        break;
+                    }
+                    if (std::abs(dj) > best) {
+                        best = std::abs(dj);
+                        q = j;
+                        dq = dj;
+                    }
+                }
+            }
+            if (q < 0) return LP_OPTIMAL;
+
+            // ratio test, x_B(t) = x_B - t * dir * alpha
+            const NT dir = (dq > NT(0)) ? NT(1) : NT(-1);
+            ftran(q);
+
+            // Harris' two pass test: find the largest step for bounds relaxed by tol,
+            // then among the rows that block before that step take the one with the largest pivot
+            NT t_relaxed = upper(q) - lower(q);
+            for (int i = 0; i < _m; ++i) {
+                const NT delta = -dir * alpha(i);
+                const int j = basis[i];
+                if (delta < -tol() && lower(j) > -infinity()) {
+                    t_relaxed = std::min(t_relaxed, (x(j) - lower(j) + tol()) / (-delta));
+                } else if (delta > tol() && upper(j) < infinity()) {
+                    t_relaxed = std::min(t_relaxed, (upper(j) - x(j) + tol()) / delta);
+                }
+            }
+            if (!(t_relaxed < infinity())) return LP_UNBOUNDED;
+
+            int r = -1;
+            NT t = upper(q) - lower(q), max_pivot = NT(0);
+            for (int i = 0; i < _m; ++i) {
+                const NT delta = -dir * alpha(i);
+                const int j = basis[i];
+                NT ti;
+                if (delta < -tol() && lower(j) > -infinity()) {
+                    ti = (x(j) - lower(j)) / (-delta);
+                } else if (delta > tol() && upper(j) < infinity()) {
+                    ti = (upper(j) - x(j)) / delta;
+                } else {
+                    continue;
+                }
+                if (ti > t_relaxed) continue;
+                if (bland ? (r < 0 || ti < t || (ti == t && j < basis[r])) : std::abs(alpha(i)) > max_pivot) {
+                    r = i;
+                    t = ti;
+                    max_pivot = std::abs(alpha(i));
+                }
+            }
+            if (r >= 0 && t >= upper(q) - lower(q)) r = -1;
+            t = std::max(t, NT(0));
+
+            degenerate = (t <= tol()) ? degenerate + 1 : 0;
+            if (degenerate > 2 * _m) bland = true;
+
+            // update the values
+            for (int i = 0; i < _m; ++i) x(basis[i]) -= t * dir * alpha(i);
+            x(q) += t * dir;
+
+            if (r < 0) { // the entering variable moves to its other bound
+                set_nonbasic(q, (dir > NT(0)) ? AT_UPPER : AT_LOWER);
+                continue;
+            }
+
+            const int leaving = basis[r];
+            set_nonbasic(leaving, (-dir * alpha(r) > NT(0)) ? AT_UPPER : AT_LOWER);
+            basis[r] = q;
+            state[q] = BASIC;
+
+            // update the inverse of the basis
+            Binv.row(r) /= alpha(r);
+            for (int i = 0; i < _m; ++i) {
+                if (i != r && alpha(i) != NT(0)) Binv.row(i) -= alpha(i) * Binv.row(r);
+            }
+        }
+        return LP_ITERATION_LIMIT;
+    }
+};
+
+
+#endif
@@ -29,6 +29,36 @@
 #undef Realloc
 #undef Free
 #include "lp_lib.h"
+#include "dense_lp.h"
+
+
+// store the i-th row of A in row and colno (lp_solve format), compute its squared norm
+// and return the number of the stored coefficients
+template <typename MT, typename NT>
+int get_lp_row(const MT &A, const int &i, REAL *row, int *colno, NT &sum) {
+    int d = A.cols();
+    sum = NT(0);
+    for (int j = 0; j < d; j++) {
+        colno[j] = j+1;
+        row[j] = A(i,j);
+        sum += A(i,j)*A(i,j);
+    }
+    return d;
+}
+
+
+// for a sparse matrix only the nonzeros of the row are stored
+template <typename NT>
+int get_lp_row(const Eigen::SparseMatrix<NT, Eigen::RowMajor> &A, const int &i, REAL *row, int *colno, NT &sum) {
+    int nz = 0;
+    sum = NT(0);
+    for (typename Eigen::SparseMatrix<NT, Eigen::RowMajor>::InnerIterator it(A, i); it; ++it, ++nz) {
+        colno[nz] = it.col()+1;
+        row[nz] = it.value();
+        sum += it.value()*it.value();
+    }
+    return nz;
+}
 
 
 // compute the chebychev ball of an H-polytope described by a dxd matrix A and  d-dimensional vector b, s.t.: Ax<=b
@@ -74,20 +104,16 @@ std::pair<Point,NT> ComputeChebychevBall(MT &A, VT &b){
     set_add_rowmode(lp, TRUE);  /* makes building the model faster if it is done rows by row */
 
     NT sum;
+    int nz;
     for (i = 0; i < m; ++i) {
         /* construct all rows */
-        sum=NT(0);
-        for(j=0; j<d; j++){
-            colno[j] = j+1;
-            row[j] = A(i,j);
-            sum+=A(i,j)*A(i,j);
-        }
-        colno[d] = d+1; /* last column */
-        row[d] = std::sqrt(sum);
+        nz = get_lp_row(A, i, row, colno, sum);
+        colno[nz] = d+1; /* last column */
+        row[nz] = std::sqrt(sum);
 
         /* add the row to lpsolve */
         try {
-            if(!add_constraintex(lp, d+1, row, colno, LE, b(i))) throw false;
+            if(!add_constraintex(lp, nz+1, row, colno, LE, b(i))) throw false;
         }
         catch (bool e)
         {
@@ -294,4 +320,59 @@ Point PointInIntersection(MT V1, MT V2, Point direction, bool &empty) {
 }
 
 
+// the LP of PointInIntersection for DenseLP:
+// V1^T lambda1 - V2^T lambda2 = 0, sum(lambda1) = sum(lambda2) = 1, lambda1, lambda2 >= 0
+template <typename MT, typename NT>
+void PointInIntersection_model(const MT &V1, const MT &V2, DenseLP<NT> &lp) {
+
+    int d = V1.cols(), k1 = V1.rows(), k2 = V2.rows();
+    lp.resize(d+2, k1+k2);
+    lp.A.topLeftCorner(d, k1) = V1.transpose();
+    lp.A.topRightCorner(d, k2) = -V2.transpose();
+    lp.A.row(d).head(k1).setOnes();
+    lp.A.row(d+1).tail(k2).setOnes();
+    lp.b(d) = NT(1);
+    lp.b(d+1) = NT(1);
+}
+
+
+// compute the point of the intersection of two V-polytopes that maximizes the objective direction
+// over the convex combinations; lp is built by PointInIntersection_model and V1 is its first V-polytope.
+// Only the objective changes between calls, so each call starts from the previous optimal basis
+template <typename VT, typename MT, typename Point, typename NT>
+Point PointInIntersection(DenseLP<NT> &lp, const MT &V1, const Point &direction, bool &empty) {
+
+    int k1 = V1.rows();
+    lp.c = direction.map();
+    if (lp.solve() != DenseLP<NT>::LP_OPTIMAL) {
+        empty = true;
+        return Point(V1.cols());
+    }
+    empty = false;
+    VT p = V1.transpose() * lp.solution().head(k1);
+    return Point(p);
+}
+
+
+// the support function h(u) = max {u^T x : A x <= b} of an H-polytope, given At = A^T, from the dual LP
+// min {b^T w : A^T w = u, w >= 0}. It has d rows and one column per facet, so DenseLP keeps a d x d basis.
+// The simplex multipliers of the optimal basis give the maximizer x. Return infinity if the LP fails,
+// e.g. if the polytope is unbounded along u
+template <typename MT, typename VT>
+typename VT::Scalar support_Hpoly(const MT &At, const VT &b, const VT &u, VT &x) {
+
+    typedef typename VT::Scalar NT;
+    DenseLP<NT> lp(At.rows(), At.cols());
+    lp.A = At;
+    lp.b = u;
+    lp.c = b;
+    if (lp.solve(false) != DenseLP<NT>::LP_OPTIMAL) {
+        x.setZero(u.rows());
+        return std::numeric_limits<NT>::infinity();
+    }
+    x = -lp.dual();
+    return lp.objective();
+}
+
+
 #endif
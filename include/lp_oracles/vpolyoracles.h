@@ -4,10 +4,12 @@
 #include <stdio.h>
 #include <cmath>
 #include <exception>
+#include <memory>
 #include "samplers.h"
 #undef Realloc
 #undef Free
 #include "lp_lib.h"
+#include "dense_lp.h"
 
 
 // return true if q belongs to the convex hull of the V-polytope described by matrix V
@@ -405,4 +407,304 @@ std::pair<NT,NT> intersect_double_line_Vpoly(const MT &V, const Point &p, const
 }
 
 
-#endif
\ No newline at end of file
+// ----- PERSISTENT LP MODELS ------------ //
+// The functions above build, solve and delete a new model in every call.
+// The following ones build the model once from V; a query updates only the coefficients that depend
+// on the query point and direction, so lp_solve starts from the optimal basis of the previous query.
+// Successive points of a random walk are close, so usually a few pivots suffice.
+
+typedef std::shared_ptr<lprec> lp_model;
+
+
+// delete the lp_solve model when the last copy of the polytope that uses it is destroyed
+inline lp_model make_lp_model(const int rows, const int cols) {
+    lprec *lp = make_lp(rows, cols);
+    if (lp == NULL) return lp_model();
+    return lp_model(lp, delete_lp);
+}
+
+
+// build the model of memLP_Vpoly. The last row and the objective function are set by each query
+template <typename MT, typename NT>
+lp_model memLP_Vpoly_model(const MT &V, NT *row, int *colno) {
+
+    int d = V.cols(), m = V.rows(), i, j;
+    lp_model model = make_lp_model(m + 1, d + 1);
+    lprec *lp = model.get();
+    if (lp == NULL) {
+#ifdef VOLESTI_DEBUG
+        std::cout<<"Could not construct Linear Program for membership"<<std::endl;
+#endif
+        return model;
+    }
+    REAL infinite = get_infinite(lp);
+
+    set_add_rowmode(lp, TRUE);
+    for (i = 0; i < m; ++i) {
+        for (j = 0; j < d; j++) {
+            colno[j] = j+1;
+            row[j] = V(i,j);
+        }
+        colno[d] = d+1;
+        row[d] = -1.0;
+        add_constraintex(lp, d+1, row, colno, LE, 0.0);
+    }
+    // the row of the query point
+    for (j = 0; j < d; j++) row[j] = 0.0;
+    add_constraintex(lp, d+1, row, colno, LE, 1.0);
+    set_add_rowmode(lp, FALSE);
+
+    for (j = 0; j < d+1; j++) set_bounds(lp, j+1, -infinite, infinite);
+    set_maxim(lp);
+    set_verbose(lp, NEUTRAL);
+    return model;
+}
+
+
+// return true if q belongs to the V-polytope of the model built by memLP_Vpoly_model
+template <typename Point, typename NT>
+bool memLP_Vpoly(lprec *lp, const Point &q, NT *row, int *colno) {
+
+    int d = q.dimension();
+    for (int j = 0; j < d; j++) {
+        colno[j] = j+1;
+        row[j] = q[j];
+    }
+    colno[d] = d+1;
+    row[d] = -1.0;
+
+    if (!set_rowex(lp, get_Nrows(lp), d+1, row, colno) || !set_obj_fnex(lp, d+1, row, colno)) {
+#ifdef VOLESTI_DEBUG
+        std::cout<<"Could not update the Linear Program for membership"<<std::endl;
+#endif
+        return false;
+    }
+    if (solve(lp) != OPTIMAL) {
+#ifdef VOLESTI_DEBUG
+        std::cout<<"Could not solve the Linear Program for memebrship"<<std::endl;
+#endif
+        return false;
+    }
+    return NT(get_objective(lp)) <= 0.0;
+}
+
+
+// build the model of intersect_line_Vpoly and intersect_double_line_Vpoly.
+// The column of the direction and the right-hand side are set by each query
+template <typename MT, typename NT>
+lp_model ray_Vpoly_model(const MT &V, NT *row, int *colno, const bool zonotope) {
+
+    int d = V.cols(), m = V.rows(), i, j;
+    lp_model model = make_lp_model(zonotope ? d : d+1, m+1);
+    lprec *lp = model.get();
+    if (lp == NULL) {
+#ifdef VOLESTI_DEBUG
+        std::cout<<"Could not construct Linear Program for ray-shooting"<<std::endl;
+#endif
+        return model;
+    }
+    REAL infinite = get_infinite(lp);
+
+    set_add_rowmode(lp, TRUE);
+    for (i = 0; i < d; i++) {
+        for (j = 0; j < m; j++) {
+            colno[j] = j+1;
+            row[j] = V(j,i);
+        }
+        colno[m] = m+1;
+        row[m] = 0.0;
+        add_constraintex(lp, m+1, row, colno, EQ, 0.0);
+    }
+    if (!zonotope) {
+        for (j = 0; j < m; j++) row[j] = 1.0;
+        row[m] = 0.0;
+        add_constraintex(lp, m+1, row, colno, EQ, 1.0);
+    }
+    set_add_rowmode(lp, FALSE);
+
+    for (j = 0; j < m; j++) {
+        set_bounds(lp, j+1, zonotope ? -1.0 : 0.0, 1.0);
+        row[j] = 0.0;
+    }
+    row[m] = 1.0;
+    set_bounds(lp, m+1, -infinite, infinite);
+    set_obj_fnex(lp, m+1, row, colno);
+    set_verbose(lp, NEUTRAL);
+    return model;
+}
+
+
+// set the ray p + lambda*v to the model built by ray_Vpoly_model
+template <typename Point, typename NT>
+bool set_ray_Vpoly(lprec *lp, const Point &p, const Point &v, NT *row, int *colno) {
+
+    int d = p.dimension(), m = get_Ncolumns(lp);
+    // the objective coefficient of the last column has to be kept
+    colno[0] = 0;
+    row[0] = 1.0;
+    for (int i = 0; i < d; i++) {
+        colno[i+1] = i+1;
+        row[i+1] = v[i];
+        set_rh(lp, i+1, p[i]);
+    }
+    if (!set_columnex(lp, m, d+1, row, colno)) {
+#ifdef VOLESTI_DEBUG
+        std::cout<<"Could not update the Linear Program for ray-shooting"<<std::endl;
+#endif
+        return false;
+    }
+    return true;
+}
+
+
+// compute the intersection of a ray with the V-polytope (or the zonotope) of the model built by ray_Vpoly_model
+// if maxi is true compute positive lambda, when the ray is p + lambda \cdot v
+// otherwise compute the negative lambda
+template <typename NT, typename Point>
+NT intersect_line_Vpoly(lprec *lp, const Point &p, const Point &v, NT *conv_comb, NT *row, int *colno,
+                        const bool maxi) {
+
+    if (!set_ray_Vpoly(lp, p, v, row, colno)) return -1.0;
+    if (maxi) {
+        set_maxim(lp);
+    } else {
+        set_minim(lp);
+    }
+    if (solve(lp) != OPTIMAL) {
+#ifdef VOLESTI_DEBUG
+        std::cout<<"Could not solve the Linear Program for ray-shooting"<<std::endl;
+#endif
+        return -1.0;
+    }
+    get_variables(lp, conv_comb);
+    return NT(-get_objective(lp));
+}
+
+
+// compute both intersections of a line with the V-polytope (or the zonotope) of the model built by ray_Vpoly_model
+template <typename NT, typename Point>
+std::pair<NT,NT> intersect_double_line_Vpoly(lprec *lp, const Point &p, const Point &v, NT *row, int *colno) {
+
+    std::pair<NT,NT> res_pair;
+    if (!set_ray_Vpoly(lp, p, v, row, colno)) return res_pair;
+
+    set_maxim(lp);
+    solve(lp);
+    res_pair.second = NT(-get_objective(lp));
+
+    set_minim(lp);
+    solve(lp);
+    res_pair.first = NT(-get_objective(lp));
+
+    return res_pair;
+}
+
+
+// ----- DENSE LP ORACLES ------------ //
+// The same oracles with the LPs solved by DenseLP (dense_lp.h). The LP of each oracle is built once
+// from V and a query sets only its right-hand side, objective or direction column. The convex
+// combination of a ray-shooting solution is lp.solution().
+
+
+// membership LP: find lambda in [0,1]^k with V^T lambda = q and sum(lambda) = 1
+template <typename MT, typename NT>
+void memLP_Vpoly_model(const MT &V, DenseLP<NT> &lp) {
+
+    int d = V.cols(), k = V.rows();
+    lp.resize(d+1, k);
+    lp.A.topRows(d) = V.transpose();
+    lp.A.row(d).setOnes();
+    lp.b(d) = NT(1);
+    lp.u.setOnes();
+}
+
+
+// return true if q belongs to the V-polytope of the LP built by memLP_Vpoly_model
+template <typename Point, typename NT>
+bool memLP_Vpoly(DenseLP<NT> &lp, const Point &q) {
+
+    lp.b.head(q.dimension()) = q.map();
+    return lp.solve() == DenseLP<NT>::LP_OPTIMAL;
+}
+
+
+// after memLP_Vpoly(lp, q) returned false, compute a halfspace a^T x <= beta of the V-polytope with
+// a^T q > beta. a is taken from the dual of phase I and beta = max_i a^T v_i, so the halfspace is valid
+// even if the dual is inexact. Return false if it does not separate q.
+template <typename MT, typename VT, typename NT, typename Point>
+bool separating_halfspace_Vpoly(const DenseLP<NT> &lp, const MT &V, const Point &q, VT &a, NT &beta) {
+
+    a = lp.infeasibility_certificate().head(V.cols());
+    NT norm = a.norm();
+    if (!(norm > NT(0))) return false;
+    a /= norm;
+    beta = (V * a).maxCoeff();
+    return a.dot(q.map()) > beta + NT(1e-9) * (NT(1) + std::abs(beta));
+}
+
+
+// ray-shooting LP: max or min t s.t. V^T lambda + t v = p, sum(lambda) = 1, lambda in [0,1]^k
+// for a zonotope drop the last row and let lambda in [-1,1]^k
+template <typename MT, typename NT>
+void ray_Vpoly_model(const MT &V, DenseLP<NT> &lp, const bool zonotope) {
+
+    int d = V.cols(), k = V.rows();
+    lp.resize(zonotope ? d : d+1, k+1);
+    lp.A.topLeftCorner(d, k) = V.transpose();
+    if (!zonotope) {
+        lp.A.row(d).head(k).setOnes();
+        lp.b(d) = NT(1);
+    }
+    lp.l.head(k).setConstant(zonotope ? NT(-1) : NT(0));
+    lp.u.head(k).setOnes();
+    lp.l(k) = -DenseLP<NT>::infinity();
+    lp.u(k) = DenseLP<NT>::infinity();
+    lp.c(k) = NT(1);
+}
+
+
+// set the ray p + lambda*v to the LP built by ray_Vpoly_model
+template <typename Point, typename NT>
+void set_ray_Vpoly(DenseLP<NT> &lp, const Point &p, const Point &v) {
+
+    int d = p.dimension(), k = lp.cols() - 1;
+    lp.A.col(k).head(d) = v.map();
+    lp.b.head(d) = p.map();
+}
+
+
+// compute the intersection of a ray with the V-polytope (or the zonotope) of the LP built by ray_Vpoly_model
+// if maxi is true compute positive lambda, when the ray is p + lambda \cdot v
+// otherwise compute the negative lambda
+template <typename NT, typename Point>
+NT intersect_line_Vpoly(DenseLP<NT> &lp, const Point &p, const Point &v, const bool maxi) {
+
+    set_ray_Vpoly(lp, p, v);
+    if (lp.solve(maxi) != DenseLP<NT>::LP_OPTIMAL) {
+#ifdef VOLESTI_DEBUG
+        std::cout<<"Could not solve the Linear Program for ray-shooting"<<std::endl;
+#endif
+        return -1.0;
+    }
+    return -lp.objective();
+}
+
+
+// compute both intersections of a line with the V-polytope (or the zonotope) of the LP built by ray_Vpoly_model
+template <typename NT, typename Point>
+std::pair<NT,NT> intersect_double_line_Vpoly(DenseLP<NT> &lp, const Point &p, const Point &v) {
+
+    std::pair<NT,NT> res_pair;
+    set_ray_Vpoly(lp, p, v);
+
+    lp.solve(true);
+    res_pair.second = -lp.objective();
+
+    lp.solve(false);
+    res_pair.first = -lp.objective();
+
+    return res_pair;
+}
+
+
+#endif
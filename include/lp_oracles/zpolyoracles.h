@@ -5,6 +5,7 @@
 #include <cmath>
 #include <exception>
 #include "samplers.h"
+#include "vpolyoracles.h"
 #undef Realloc
 #undef Free
 #include "lp_lib.h"
@@ -199,4 +200,97 @@ std::pair<NT,NT> intersect_line_zono(const MT &V, const Point &p, const Point &v
 }
 
 
+// build the model of memLP_Zonotope. The right-hand side is set by each query
+template <typename MT, typename NT>
+lp_model memLP_Zonotope_model(const MT &V, NT *row, int *colno) {
+
+    int d = V.cols(), Ncol = V.rows(), i, j;
+    lp_model model = make_lp_model(d, Ncol);
+    lprec *lp = model.get();
+    if (lp == NULL) {
+#ifdef VOLESTI_DEBUG
+        std::cout<<"Could not construct Linear Program for membership"<<std::endl;
+#endif
+        return model;
+    }
+
+    set_add_rowmode(lp, TRUE);
+    for (i = 0; i < d; ++i) {
+        for (j = 0; j < Ncol; j++) {
+            colno[j] = j+1;
+            row[j] = V(j,i);
+        }
+        add_constraintex(lp, Ncol, row, colno, EQ, 0.0);
+    }
+    set_add_rowmode(lp, FALSE);
+
+    for (j = 0; j < Ncol; j++) {
+        row[j] = 0.0;
+        set_bounds(lp, j+1, -1.0, 1.0);
+    }
+    set_obj_fnex(lp, Ncol, row, colno);
+    set_maxim(lp);
+    set_verbose(lp, NEUTRAL);
+    return model;
+}
+
+
+// return true if q belongs to the zonotope of the model built by memLP_Zonotope_model
+template <typename Point>
+bool memLP_Zonotope(lprec *lp, const Point &q) {
+
+    for (int i = 0; i < q.dimension(); ++i) set_rh(lp, i+1, q[i]);
+    return solve(lp) == OPTIMAL;
+}
+
+
+// compute both intersections of a line with the zonotope of the model built by ray_Vpoly_model
+template <typename NT, typename Point>
+std::pair<NT,NT> intersect_line_zono(lprec *lp, const Point &p, const Point &v, NT *row, int *colno) {
+    return intersect_double_line_Vpoly(lp, p, v, row, colno);
+}
+
+
+// membership LP of DenseLP: find lambda in [-1,1]^k with V^T lambda = q
+template <typename MT, typename NT>
+void memLP_Zonotope_model(const MT &V, DenseLP<NT> &lp) {
+
+    lp.resize(V.cols(), V.rows());
+    lp.A = V.transpose();
+    lp.l.setConstant(NT(-1));
+    lp.u.setOnes();
+}
+
+
+// return true if q belongs to the zonotope of the LP built by memLP_Zonotope_model
+template <typename Point, typename NT>
+bool memLP_Zonotope(DenseLP<NT> &lp, const Point &q) {
+
+    lp.b = q.map();
+    return lp.solve() == DenseLP<NT>::LP_OPTIMAL;
+}
+
+
+// after memLP_Zonotope(lp, q) returned false, compute a halfspace a^T x <= beta of the zonotope with
+// a^T q > beta, where beta = sum_i |a^T v_i| is the support function of the zonotope in direction a.
+// Return false if it does not separate q.
+template <typename MT, typename VT, typename NT, typename Point>
+bool separating_halfspace_Zonotope(const DenseLP<NT> &lp, const MT &V, const Point &q, VT &a, NT &beta) {
+
+    a = lp.infeasibility_certificate();
+    NT norm = a.norm();
+    if (!(norm > NT(0))) return false;
+    a /= norm;
+    beta = (V * a).cwiseAbs().sum();
+    return a.dot(q.map()) > beta + NT(1e-9) * (NT(1) + beta);
+}
+
+
+// compute both intersections of a line with the zonotope of the LP built by ray_Vpoly_model
+template <typename NT, typename Point>
+std::pair<NT,NT> intersect_line_zono(DenseLP<NT> &lp, const Point &p, const Point &v) {
+    return intersect_double_line_Vpoly(lp, p, v);
+}
+
+
 #endif
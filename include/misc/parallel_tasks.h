@@ -0,0 +1,40 @@
+// VolEsti (volume computation and sampling library)
+
+// Copyright (c) 20012-2019 Vissarion Fisikopoulos
+// Copyright (c) 2018-2019 Apostolos Chalkis
+
+// Licensed under GNU LGPL.3, see LICENCE file
+
+#ifndef PARALLEL_TASKS_H
+#define PARALLEL_TASKS_H
+
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+
+// Run the independent tasks 0,...,num_tasks-1 on at most n_threads threads, task(i, t) runs the i-th task
+// on the t-th thread. The threads take the tasks from a shared counter, each one the next task as soon as
+// it finishes the previous one, so the tasks need not have the same cost and the running time is about
+// that of the longest task when there are enough threads. With one thread the tasks run in order.
+// The tasks must not throw.
+template <typename Task>
+void run_tasks(const unsigned int num_tasks, const unsigned int n_threads, Task task) {
+
+    const unsigned int threads = std::max(1u, std::min(n_threads, num_tasks));
+    if (threads == 1) {
+        for (unsigned int i = 0; i < num_tasks; ++i) task(i, 0);
+        return;
+    }
+
+    std::atomic<unsigned int> next(0);
+    std::vector<std::thread> workers;
+    for (unsigned int t = 0; t < threads; t++) {
+        workers.push_back(std::thread([&, t]() {
+            for (unsigned int i = next++; i < num_tasks; i = next++) task(i, t);
+        }));
+    }
+    for (unsigned int t = 0; t < threads; t++) workers[t].join();
+}
+
+#endif
@@ -19,6 +19,19 @@
 
 
 // ----- ROUNDING ------ //
+// Khachiyan's implementation works on ublas matrices, so the contiguous d x N block of the
+// sample store is copied once, column by column, to the ublas matrix Ap (d x N)
+template <typename PointStore>
+void store_to_ublas(const PointStore &randPoints, boost::numeric::ublas::matrix<double> &Ap) {
+
+    const unsigned int n = randPoints.dimension();
+    const typename PointStore::NT *pit = randPoints.data();
+    for (unsigned int j = 0; j < randPoints.size(); ++j) {
+        for (unsigned int i = 0; i < n; ++i, ++pit) Ap(i, j) = double(*pit);
+    }
+}
+
+
 // main rounding function
 template <typename Polytope, typename Point, typename Parameters, typename NT>
 std::pair <NT, NT> rounding_min_ellipsoid(Polytope &P , const std::pair<Point,NT> &InnerBall, const Parameters &var) {
@@ -26,16 +39,16 @@ std::pair <NT, NT> rounding_min_ellipsoid(Polytope &P , const std::pair<Point,NT
     typedef typename Polytope::MT 	MT;
     typedef typename Polytope::VT 	VT;
     typedef typename Parameters::RNGType RNGType;
-    unsigned int n=var.n, walk_len=var.walk_steps, i, j = 0;
+    unsigned int n=var.n, walk_len=var.walk_steps;
     Point c = InnerBall.first;
     NT radius = InnerBall.second;
-    std::list<Point> randPoints; //ds for storing rand points
+    PointStore<Point> randPoints(n); //ds for storing rand points
     if (!P.get_points_for_rounding(randPoints)) {  // If P is a V-polytope then it will store its vertices in randPoints
         // If P is not a V-Polytope or number_of_vertices>20*domension
         // 2. Generate the first random point in P
         // Perform random walk on random point in the Chebychev ball
-        Point p = get_point_in_Dsphere<RNGType, Point>(n, radius);
-        p = p + c;
+        Point p = get_point_in_Dsphere<RNGType, Point>(n, radius, var.rng);
+        p += c;
 
         //use a large walk length e.g. 1000
         rand_point_generator(P, p, 1, 10*n, randPoints, var);
@@ -49,16 +62,9 @@ std::pair <NT, NT> rounding_min_ellipsoid(Polytope &P , const std::pair<Point,NT
         }
     }
 
-    // Store points in a matrix to call Khachiyan algorithm for the minimum volume enclosing ellipsoid
+    // Copy the points to a ublas matrix to call Khachiyan algorithm for the minimum volume enclosing ellipsoid
     boost::numeric::ublas::matrix<double> Ap(n,randPoints.size());
-    typename std::list<Point>::iterator rpit=randPoints.begin();
-    typename std::vector<NT>::iterator qit;
-    for ( ; rpit!=randPoints.end(); rpit++, j++) {
-        qit = (*rpit).iter_begin(); i=0;
-        for ( ; qit!=(*rpit).iter_end(); qit++, i++){
-            Ap(i,j)=double(*qit);
-        }
-    }
+    store_to_ublas(randPoints, Ap);
     boost::numeric::ublas::matrix<double> Q(n,n);
     boost::numeric::ublas::vector<double> c2(n);
     size_t w=1000;
@@ -106,20 +112,13 @@ void get_vpoly_center(Polytope &P) {
     typedef typename Polytope::VT 	VT;
     typedef typename Polytope::PolytopePoint 	Point;
 
-    unsigned int n = P.dimension(), i, j = 0;
+    unsigned int n = P.dimension();
 
-    std::list<Point> randPoints; //ds for storing rand points
+    PointStore<Point> randPoints(n); //ds for storing rand points
     P.get_points_for_rounding(randPoints);
 
     boost::numeric::ublas::matrix<double> Ap(n,randPoints.size());
-    typename std::list<Point>::iterator rpit=randPoints.begin();
-    typename std::vector<NT>::iterator qit;
-    for ( ; rpit!=randPoints.end(); rpit++, j++) {
-        qit = (*rpit).iter_begin(); i=0;
-        for ( ; qit!=(*rpit).iter_end(); qit++, i++){
-            Ap(i,j)=double(*qit);
-        }
-    }
+    store_to_ublas(randPoints, Ap);
     boost::numeric::ublas::matrix<double> Q(n,n);
     boost::numeric::ublas::vector<double> c2(n);
     size_t w=1000;
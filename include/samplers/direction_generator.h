@@ -0,0 +1,85 @@
+// VolEsti (volume computation and sampling library)
+
+// Copyright (c) 20012-2019 Vissarion Fisikopoulos
+// Copyright (c) 2018-2019 Apostolos Chalkis
+
+// Licensed under GNU LGPL.3, see LICENCE file
+
+#ifndef DIRECTION_GENERATOR_H
+#define DIRECTION_GENERATOR_H
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+
+// Generates uniformly distributed unit directions in blocks.
+// A block of `block` directions of dimension dim is kept in one contiguous buffer.
+// The normals of a block are computed with the Box-Muller transform in two flat loops
+// (all the uniforms first, then the transform) so that the compiler can vectorize them,
+// and next() copies one direction into an existing point without allocating.
+template <typename NT>
+class DirectionGenerator {
+public:
+
+    DirectionGenerator(const unsigned int block = 32) : dim(0), block(block), next_dir(block) {}
+
+    // copy the next unit direction of dimension v.dimension() into v
+    template <typename RNGType, typename Point>
+    void next(Point &v, RNGType &rng) {
+        const unsigned int d = v.dimension();
+        if (next_dir == block || d != dim) fill(d, rng);
+        typename std::vector<NT>::const_iterator dit = buffer.begin() + next_dir * dim;
+        std::copy(dit, dit + dim, v.iter_begin());
+        next_dir++;
+    }
+
+    // drop the directions left in the buffer
+    void reset() {
+        next_dir = block;
+    }
+
+private:
+    unsigned int dim;
+    unsigned int block;
+    unsigned int next_dir;
+    std::vector<NT> buffer;
+
+    template <typename RNGType>
+    void fill(const unsigned int &d, RNGType &rng) {
+
+        const NT two_pi = NT(2) * NT(M_PI);
+        const unsigned int pairs = (d * block + 1) / 2;
+
+        if (d != dim) {
+            dim = d;
+            buffer.resize(2 * pairs);
+        }
+
+        // uniforms in (0,1]: the first half is used for the radius, the second half for the angle
+        const NT scale = NT(1) / (NT(RNGType::max()) - NT(RNGType::min()) + NT(1));
+        for (unsigned int i = 0; i < 2 * pairs; ++i) {
+            buffer[i] = (NT(rng() - RNGType::min()) + NT(1)) * scale;
+        }
+
+        NT *u1 = &buffer[0], *u2 = &buffer[pairs];
+        for (unsigned int i = 0; i < pairs; ++i) {
+            const NT r = std::sqrt(NT(-2) * std::log(u1[i]));
+            const NT theta = two_pi * u2[i];
+            u1[i] = r * std::cos(theta);
+            u2[i] = r * std::sin(theta);
+        }
+
+        NT *x = &buffer[0], normal;
+        for (unsigned int j = 0; j < block; ++j, x += dim) {
+            normal = NT(0);
+            for (unsigned int i = 0; i < dim; ++i) normal += x[i] * x[i];
+            normal = NT(1) / std::sqrt(normal);
+            for (unsigned int i = 0; i < dim; ++i) x[i] *= normal;
+        }
+        next_dir = 0;
+    }
+};
+
+
+#endif
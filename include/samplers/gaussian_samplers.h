@@ -82,7 +82,8 @@ void rand_exp_range(Point &lower, Point &upper, const NT &a_i, Point &p, Paramet
                 break;
             }
         }
-        p = (r * b) + z;
+        p = z;
+        p.axpy(r, b);
 
     // select using rejection sampling from a bounding rectangle
     } else {
@@ -90,8 +91,9 @@ void rand_exp_range(Point &lower, Point &upper, const NT &a_i, Point &p, Paramet
         NT M = get_max(lower, upper, a_i);
         while (true) {
             r = urdist(rng2);
-            Point pef = r * upper;
-            p = ((1.0 - r) * lower) + pef;
+            p = lower;
+            p *= (1.0 - r);
+            p.axpy(r, upper);
             r_val = M * urdist(var.rng);
             fn = eval_exp(p, a_i);
             if (r_val < fn) {
@@ -141,122 +143,144 @@ NT rand_exp_range_coord(const NT &l, const NT &u, const NT &a_i, Parameters cons
 }
 
 
-// compute the first coordinate point
-template <typename Polytope, typename Point, typename Parameters, typename NT>
-void gaussian_first_coord_point(Polytope &P,
-                         Point &p,   // a point to start
-                         Point &p_prev, // previous point
-                         unsigned int &coord_prev, // previous coordinate ray
-                         unsigned int walk_len, // number of steps for the random walk
-                         const NT &a_i,
-                         std::vector<NT> &lamdas,
-                         Parameters const& var) {
-    typedef typename Parameters::RNGType RNGType;
-    unsigned int n = var.n, rand_coord;
-    boost::random::uniform_int_distribution<> uidist(0, n - 1);
-    //unsigned seed = std::chrono::system_clock::now().time_since_epoch().count();
-    //RNGType rng(seed);
-    RNGType &rng2 = var.rng;
+// Random walks with target distribution exp(-a_i||x||^2) as policy types.
+// As in random_walks.h every policy has a nested class Walk<Polytope, Point, Parameters>:
+// Walk(P, p, a_i, var) performs the first step from p and apply(P, p, a_i, walk_len, var) performs walk_len steps.
+// a_i may change between the calls of apply() while the state of the chain is kept.
 
-    rand_coord = uidist(rng2);
-    std::pair <NT, NT> bpair = P.line_intersect_coord(p, rand_coord, lamdas);
-    NT dis = rand_exp_range_coord(p[rand_coord] + bpair.second, p[rand_coord] + bpair.first, a_i, var);
-    p_prev = p;
-    coord_prev = rand_coord;
-    p.set_coord(rand_coord, dis);
-    walk_len--;
+// ball walk with radius var.delta
+struct GaussianBallWalk {
 
-    for (unsigned int j = 0; j < walk_len; j++) {
-        rand_coord = uidist(rng2);
-        gaussian_hit_and_run_coord_update(p, p_prev, P, rand_coord, coord_prev, a_i, lamdas, var);
-        coord_prev = rand_coord;
-    }
-}
+    template <typename Polytope, typename Point, typename Parameters>
+    struct Walk {
+        typedef typename Point::FT NT;
 
+        Walk(Polytope &P, Point &p, const NT &a_i, const Parameters &var) {
+            gaussian_ball_walk(p, P, a_i, var.delta, var);
+        }
 
-// Compute the next point with target distribution the gaussian
-template <typename Polytope, typename Point, typename Parameters, typename NT>
-void gaussian_next_point(Polytope &P,
-                        Point &p,   // a point to start
-                        Point &p_prev, // previous point
-                        unsigned int &coord_prev, // previous coordinate ray
-                        const unsigned int walk_len, // number of steps for the random walk
-                        const NT &a_i,
-                        std::vector<NT> &lamdas,
-                        Parameters const& var) {
-    typedef typename Parameters::RNGType RNGType;
-    unsigned int n = var.n, rand_coord;
-    boost::random::uniform_int_distribution<> uidist(0, n - 1);
-    //unsigned seed = std::chrono::system_clock::now().time_since_epoch().count();
-    //RNGType rng(seed);
-    RNGType &rng2 = var.rng;
-    NT ball_rad = var.delta;
-
-    for (unsigned int j = 0; j < walk_len; j++) {
-        if (var.ball_walk) {
-            gaussian_ball_walk(p, P, a_i, ball_rad, var);
-        } else if (var.cdhr_walk) {
-            rand_coord = uidist(rng2);
-            gaussian_hit_and_run_coord_update(p, p_prev, P, rand_coord, coord_prev, a_i, lamdas, var);
-            coord_prev = rand_coord;
-        } else {
+        void apply(Polytope &P, Point &p, const NT &a_i, const unsigned int walk_len, const Parameters &var) {
+            for (unsigned int j = 0; j < walk_len; ++j) gaussian_ball_walk(p, P, a_i, var.delta, var);
+        }
+    };
+};
+
+
+// hit-and-run with coordinate directions
+struct GaussianCDHRWalk {
+
+    template <typename Polytope, typename Point, typename Parameters>
+    struct Walk {
+        typedef typename Point::FT NT;
+
+        Walk(Polytope &P, Point &p, const NT &a_i, const Parameters &var) : p_prev(p),
+                lamdas(P.num_of_hyperplanes(), NT(0)), uidist(0, var.n - 1) {
+            rand_coord = uidist(var.rng);
+            std::pair <NT, NT> bpair = P.line_intersect_coord(p, rand_coord, lamdas);
+            NT dis = rand_exp_range_coord(p[rand_coord] + bpair.second, p[rand_coord] + bpair.first, a_i, var);
+            p_prev = p;
+            p.set_coord(rand_coord, dis);
+        }
+
+        void apply(Polytope &P, Point &p, const NT &a_i, const unsigned int walk_len, const Parameters &var) {
+            unsigned int rand_coord_prev;
+            for (unsigned int j = 0; j < walk_len; ++j) {
+                rand_coord_prev = rand_coord;
+                rand_coord = uidist(var.rng);
+                gaussian_hit_and_run_coord_update(p, p_prev, P, rand_coord, rand_coord_prev, a_i, lamdas, var);
+            }
+        }
+
+        Point p_prev;
+        unsigned int rand_coord;
+        std::vector<NT> lamdas;
+        boost::random::uniform_int_distribution<> uidist;
+    };
+};
+
+
+// hit-and-run with random directions
+struct GaussianRDHRWalk {
+
+    template <typename Polytope, typename Point, typename Parameters>
+    struct Walk {
+        typedef typename Point::FT NT;
+
+        Walk(Polytope &P, Point &p, const NT &a_i, const Parameters &var) {
             gaussian_hit_and_run(p, P, a_i, var);
         }
+
+        void apply(Polytope &P, Point &p, const NT &a_i, const unsigned int walk_len, const Parameters &var) {
+            for (unsigned int j = 0; j < walk_len; ++j) gaussian_hit_and_run(p, P, a_i, var);
+        }
+    };
+};
+
+
+// Sample rnum points with target distribution the gaussian exp(-a_i||x||^2) using the random walk WalkPolicy
+template <typename WalkPolicy, typename Polytope, typename Parameters, typename Point, typename PointList, typename NT>
+void rand_gaussian_point_generator(Polytope &P,
+                         Point &p,   // a point to start
+                         const unsigned int rnum,   // number of points to sample
+                         const unsigned int walk_len,  // number of stpes for the random walk
+                         PointList &randPoints,  // list to store the sampled points
+                         const NT &a_i,
+                         Parameters const& var)  // constans for volume
+{
+    if (rnum == 0) return;
+    typename WalkPolicy::template Walk<Polytope, Point, Parameters> walk(P, p, a_i, var);
+
+    // the first step is made by the constructor
+    walk.apply(P, p, a_i, walk_len - 1, var);
+    randPoints.push_back(p);
+
+    for (unsigned  int i = 1; i < rnum; ++i) {
+        walk.apply(P, p, a_i, walk_len, var);
+        randPoints.push_back(p);
     }
 }
 
 
-// Sample N points with target distribution the gaussian
+// Sample rnum points with target distribution the gaussian exp(-a_i||x||^2)
+// using the random walk that is selected by the flags of var
 template <typename Polytope, typename Parameters, typename Point, typename PointList, typename NT>
 void rand_gaussian_point_generator(Polytope &P,
                          Point &p,   // a point to start
-                         unsigned int rnum,   // number of points to sample
+                         const unsigned int rnum,   // number of points to sample
                          const unsigned int walk_len,  // number of stpes for the random walk
                          PointList &randPoints,  // list to store the sampled points
                          const NT &a_i,
                          Parameters const& var)  // constans for volume
 {
-    typedef typename Parameters::RNGType RNGType;
-    unsigned int n = var.n;
-    //unsigned seed = std::chrono::system_clock::now().time_since_epoch().count();
-    //RNGType rng(seed);
-    RNGType &rng2 = var.rng;
-    boost::random::uniform_int_distribution<> uidist(0, n - 1);
-
-    std::vector <NT> lamdas(P.num_of_hyperplanes(), NT(0));
-    unsigned int rand_coord = uidist(rng2), coord_prev, rand_coord_prev;
-    NT ball_rad = var.delta;
-    Point p_prev = p;
-
-    if (var.cdhr_walk) {
-        rand_coord = uidist(rng2);
-        std::pair <NT, NT> bpair = P.line_intersect_coord(p, rand_coord, lamdas);
-        NT dis = rand_exp_range_coord(p[rand_coord] + bpair.second, p[rand_coord] + bpair.first, a_i, var);
-        p_prev = p;
-        coord_prev = rand_coord;
-        p.set_coord(rand_coord, dis);
-        for (unsigned int j = 0; j < walk_len - 1; ++j) {
-            rand_coord = uidist(rng2);
-            gaussian_hit_and_run_coord_update(p, p_prev, P, rand_coord, coord_prev, a_i, lamdas, var);
-            coord_prev = rand_coord;
-        }
-        randPoints.push_back(p);
-        rnum--;
+    if (var.ball_walk) {
+        rand_gaussian_point_generator<GaussianBallWalk>(P, p, rnum, walk_len, randPoints, a_i, var);
+    } else if (var.cdhr_walk) {
+        rand_gaussian_point_generator<GaussianCDHRWalk>(P, p, rnum, walk_len, randPoints, a_i, var);
+    } else {
+        rand_gaussian_point_generator<GaussianRDHRWalk>(P, p, rnum, walk_len, randPoints, a_i, var);
     }
+}
 
-    for (unsigned  int i = 1; i <= rnum; ++i) {
-        for (unsigned int j = 0; j < walk_len; ++j) {
-            if (var.ball_walk) {
-                gaussian_ball_walk(p, P, a_i, ball_rad, var);
-            } else if (var.cdhr_walk) {
-                rand_coord_prev = rand_coord;
-                rand_coord = uidist(rng2);
-                gaussian_hit_and_run_coord_update(p, p_prev, P, rand_coord, rand_coord_prev, a_i, lamdas, var);
-            } else
-                gaussian_hit_and_run(p, P, a_i, var);
-        }
-        randPoints.push_back(p);
+
+// Sample rnum points from the gaussian exp(-a_i||x||^2) with var.n_threads parallel chains of the random walk
+// WalkPolicy (see sample_parallel_chains). With one thread this is rand_gaussian_point_generator.
+template <typename WalkPolicy, typename Polytope, typename Parameters, typename Point, typename PointList, typename NT>
+void parallel_rand_gaussian_point_generator(Polytope &P,
+                         Point &p,   // a point to start
+                         const unsigned int rnum,   // number of points to sample
+                         const unsigned int walk_len,  // number of stpes for the random walk
+                         PointList &randPoints,  // list to store the sampled points
+                         const NT &a_i,
+                         Parameters const& var)  // constans for volume
+{
+    if (var.n_threads <= 1 || rnum <= 1) {
+        rand_gaussian_point_generator<WalkPolicy>(P, p, rnum, walk_len, randPoints, a_i, var);
+        return;
     }
+    sample_parallel_chains(P, p, rnum, randPoints, var, [walk_len, &a_i](Polytope &Q, Point &q,
+            const unsigned int num, std::vector<Point> &points, const Parameters &vark) {
+        rand_gaussian_point_generator<WalkPolicy>(Q, q, num, walk_len, points, a_i, vark);
+    });
 }
 
 
@@ -266,16 +290,16 @@ void gaussian_hit_and_run(Point &p,
                 Polytope &P,
                 const NT &a_i,
                 Parameters const& var) {
-    typedef typename Parameters::RNGType RNGType;
     unsigned int n = var.n;
-    RNGType rng2 = var.rng;
-    Point l = get_direction<RNGType, Point, NT>(n);
+    Point l(n);
+    var.dirs.next(l, var.rng);
     std::pair <NT, NT> dbpair = P.line_intersect(p, l);
 
     NT min_plus = dbpair.first;
     NT max_minus = dbpair.second;
-    Point upper = (min_plus * l) + p;
-    Point lower = (max_minus * l) + p;
+    Point upper = p, lower = p;
+    upper.axpy(min_plus, l);
+    lower.axpy(max_minus, l);
 
     rand_exp_range(lower, upper, a_i, p, var);
 }
@@ -309,13 +333,15 @@ void gaussian_ball_walk(Point & p,
     typedef typename Parameters::RNGType RNGType;
     unsigned int n = P.dimension();
     NT f_x, f_y, rnd;
-    Point y = get_point_in_Dsphere<RNGType, Point>(n, ball_rad);
-    y = y + p;
-    f_x = eval_exp(p, a_i);
-    //unsigned seed = std::chrono::system_clock::now().time_since_epoch().count();
-    //RNGType rng(seed);
     RNGType &rng2 = var.rng;
     boost::random::uniform_real_distribution<> urdist(0, 1);
+    Point y(n);
+    var.dirs.next(y, rng2);
+    NT r = ball_rad * std::pow(NT(urdist(rng2)), 1.0/(NT(n)));
+
+    y *= r;
+    y += p;
+    f_x = eval_exp(p, a_i);
     if (P.is_in(y) == -1) {
         f_y = eval_exp(y, a_i);
         rnd = urdist(rng2);
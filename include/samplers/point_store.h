@@ -0,0 +1,146 @@
+// VolEsti (volume computation and sampling library)
+
+// Copyright (c) 20012-2019 Vissarion Fisikopoulos
+// Copyright (c) 2018-2019 Apostolos Chalkis
+
+// Licensed under GNU LGPL.3, see LICENCE file
+
+#ifndef POINT_STORE_H
+#define POINT_STORE_H
+
+#include <algorithm>
+
+
+// Contiguous storage for sample points.
+// The points are the columns of a column-major d x capacity matrix and size() of them are in use.
+// push_back() copies the coordinates of a point into the next free column and doubles the capacity
+// when the block is full, so that a sequence of samples costs O(log N) allocations in total.
+// The samplers only need push_back(), so a PointStore can be passed wherever a std::list<Point> is.
+template <typename Point>
+class PointStore {
+public:
+    typedef Point value_type;
+    typedef typename Point::FT NT;
+    typedef Eigen::Matrix<NT, Eigen::Dynamic, Eigen::Dynamic> MT;
+    typedef Eigen::Matrix<NT, Eigen::Dynamic, 1> VT;
+    typedef typename MT::ColXpr ColXpr;
+    typedef typename MT::ConstColXpr ConstColXpr;
+    typedef Eigen::Block<MT, Eigen::Dynamic, Eigen::Dynamic, true> Block;
+    typedef const Eigen::Block<const MT, Eigen::Dynamic, Eigen::Dynamic, true> ConstBlock;
+
+    PointStore() : _d(0), num(0) {}
+
+    PointStore(const unsigned int dim, const unsigned int capacity = 0) : _d(dim), num(0) {
+        points.resize(dim, capacity);
+    }
+
+    unsigned int dimension() const {
+        return _d;
+    }
+
+    unsigned int size() const {
+        return num;
+    }
+
+    unsigned int capacity() const {
+        return points.cols();
+    }
+
+    bool empty() const {
+        return num == 0;
+    }
+
+    // drop the points but keep the allocated block
+    void clear() {
+        num = 0;
+    }
+
+    void reserve(const unsigned int capacity) {
+        if (capacity > points.cols()) points.conservativeResize(_d, capacity);
+    }
+
+    void push_back(const Point &p) {
+        if (_d == 0) {
+            _d = p.dimension();
+            points.resize(_d, points.cols());
+        }
+        if (num == points.cols()) reserve(std::max(2 * num, 16u));
+        std::copy(p.data(), p.data() + _d, points.col(num).data());
+        num++;
+    }
+
+    ColXpr col(const unsigned int i) {
+        return points.col(i);
+    }
+
+    ConstColXpr col(const unsigned int i) const {
+        return points.col(i);
+    }
+
+    // copy the i-th point into q without allocating
+    void get_point(const unsigned int i, Point &q) const {
+        std::copy(points.col(i).data(), points.col(i).data() + _d, q.iter_begin());
+    }
+
+    Point get_point(const unsigned int i) const {
+        Point q(_d);
+        get_point(i, q);
+        return q;
+    }
+
+    // the d x size() block of the stored points
+    Block matrix() {
+        return points.leftCols(num);
+    }
+
+    ConstBlock matrix() const {
+        return points.leftCols(num);
+    }
+
+    // column-major coordinates of the points, i.e. the j-th coordinate of the i-th point is data()[i*d + j]
+    const NT* data() const {
+        return points.data();
+    }
+
+    // Keep in place the points whose column satisfies keep(col) and drop the others.
+    // The kept points remain in their original order. Returns the number of the kept points.
+    template <typename Predicate>
+    unsigned int partition(Predicate keep) {
+        unsigned int k = 0;
+        for (unsigned int i = 0; i < num; ++i) {
+            if (keep(points.col(i))) {
+                if (k != i) points.col(k) = points.col(i);
+                k++;
+            }
+        }
+        num = k;
+        return num;
+    }
+
+    // keep the points in the ball centered at the origin with radius sqrt(squared_radius)
+    unsigned int keep_in_ball(const NT &squared_radius) {
+        unsigned int k = 0;
+        for (unsigned int i = 0; i < num; ++i) {
+            if (points.col(i).squaredNorm() <= squared_radius) {
+                if (k != i) points.col(k) = points.col(i);
+                k++;
+            }
+        }
+        num = k;
+        return num;
+    }
+
+    // the maximum squared euclidean norm of the stored points
+    NT max_squared_norm() const {
+        if (num == 0) return NT(0);
+        return matrix().colwise().squaredNorm().maxCoeff();
+    }
+
+private:
+    unsigned int _d;
+    unsigned int num;
+    MT points;
+};
+
+
+#endif
@@ -0,0 +1,153 @@
+// VolEsti (volume computation and sampling library)
+
+// Copyright (c) 20012-2019 Vissarion Fisikopoulos
+// Copyright (c) 2018-2019 Apostolos Chalkis
+
+// Licensed under GNU LGPL.3, see LICENCE file
+
+#ifndef RANDOM_WALKS_H
+#define RANDOM_WALKS_H
+
+
+// Random walks with uniform target distribution as policy types.
+// Every policy has a nested class Walk<Polytope, Point, Parameters> that keeps the state of one chain:
+//  - the constructor Walk(P, p, var) performs the first step from p and initializes the cached
+//    products of the walk (e.g. A*p for CDHR) with the full boundary oracle,
+//  - apply(P, p, walk_len, var) performs walk_len steps that update the cached products.
+// The generators, the ratio estimators and the volume algorithms are templated on the policy,
+// so the walk is selected once per call (see rand_point_generator) and not in every step.
+
+
+// ball walk with radius var.delta
+struct BallWalk {
+
+    template <typename Polytope, typename Point, typename Parameters>
+    struct Walk {
+
+        Walk(Polytope &P, Point &p, const Parameters &var) : y(var.n) {
+            ball_walk(p, P, var.delta, y, var);
+        }
+
+        // var.delta is read in every call as the annealing schedules update it between calls
+        void apply(Polytope &P, Point &p, const unsigned int walk_len, const Parameters &var) {
+            for (unsigned int j = 0; j < walk_len; ++j) ball_walk(p, P, var.delta, y, var);
+        }
+
+        Point y;
+    };
+};
+
+
+// hit-and-run with coordinate directions
+struct CDHRWalk {
+
+    template <typename Polytope, typename Point, typename Parameters>
+    struct Walk {
+        typedef typename Point::FT NT;
+
+        Walk(Polytope &P, Point &p, const Parameters &var) : p_prev(p), lamdas(P.num_of_hyperplanes(), NT(0)),
+                                                             uidist(0, var.n - 1) {
+            rand_coord = uidist(var.rng);
+            NT kapa = urdist(var.rng);
+            std::pair <NT, NT> bpair = P.line_intersect_coord(p, rand_coord, lamdas);
+            p_prev = p;
+            p.set_coord(rand_coord, p[rand_coord] + bpair.first + kapa * (bpair.second - bpair.first));
+        }
+
+        void apply(Polytope &P, Point &p, const unsigned int walk_len, const Parameters &var) {
+            unsigned int rand_coord_prev;
+            NT kapa;
+            for (unsigned int j = 0; j < walk_len; ++j) {
+                rand_coord_prev = rand_coord;
+                rand_coord = uidist(var.rng);
+                kapa = urdist(var.rng);
+                hit_and_run_coord_update(p, p_prev, P, rand_coord, rand_coord_prev, kapa, lamdas);
+            }
+        }
+
+        Point p_prev;
+        unsigned int rand_coord;
+        std::vector<NT> lamdas;
+        boost::random::uniform_int_distribution<> uidist;
+        boost::random::uniform_real_distribution<> urdist;
+    };
+};
+
+
+// hit-and-run with random directions
+struct RDHRWalk {
+
+    template <typename Polytope, typename Point, typename Parameters>
+    struct Walk {
+        typedef typename Point::FT NT;
+
+        Walk(Polytope &P, Point &p, const Parameters &var) : lamdas(P.num_of_hyperplanes(), NT(0)),
+                                                             Av(P.num_of_hyperplanes(), NT(0)), v(var.n) {
+            var.dirs.next(v, var.rng);
+            std::pair <NT, NT> bpair = P.line_intersect(p, v, lamdas, Av);
+            lambda = urdist(var.rng) * (bpair.first - bpair.second) + bpair.second;
+            p.axpy(lambda, v);
+        }
+
+        void apply(Polytope &P, Point &p, const unsigned int walk_len, const Parameters &var) {
+            for (unsigned int j = 0; j < walk_len; ++j) {
+                var.dirs.next(v, var.rng);
+                std::pair <NT, NT> bpair = P.line_intersect(p, v, lamdas, Av, lambda);
+                lambda = urdist(var.rng) * (bpair.first - bpair.second) + bpair.second;
+                p.axpy(lambda, v);
+            }
+        }
+
+        NT lambda;
+        std::vector<NT> lamdas, Av;
+        Point v;
+        boost::random::uniform_real_distribution<> urdist;
+    };
+};
+
+
+// billiard walk with trajectories of length at most var.diameter
+struct BilliardWalk {
+
+    template <typename Polytope, typename Point, typename Parameters>
+    struct Walk {
+        typedef typename Point::FT NT;
+
+        Walk(Polytope &P, Point &p, const Parameters &var) : lamdas(P.num_of_hyperplanes(), NT(0)),
+                                                             Av(P.num_of_hyperplanes(), NT(0)), v(var.n), p0(var.n) {
+            billiard_walk(P, p, var.diameter, lamdas, Av, lambda, v, p0, var, true);
+        }
+
+        void apply(Polytope &P, Point &p, const unsigned int walk_len, const Parameters &var) {
+            for (unsigned int j = 0; j < walk_len; ++j) {
+                billiard_walk(P, p, var.diameter, lamdas, Av, lambda, v, p0, var);
+            }
+        }
+
+        NT lambda;
+        std::vector<NT> lamdas, Av;
+        Point v, p0;
+    };
+};
+
+
+// Exact uniform sampling from a ball centered at the origin, i.e. every step draws a new independent point.
+// Use it only with a Ball.
+struct ExactBallSampler {
+
+    template <typename Ball, typename Point, typename Parameters>
+    struct Walk {
+        typedef typename Parameters::RNGType RNGType;
+
+        Walk(Ball &B, Point &p, const Parameters &var) {
+            p = get_point_in_Dsphere<RNGType, Point>(var.n, B.radius(), var.rng);
+        }
+
+        void apply(Ball &B, Point &p, const unsigned int walk_len, const Parameters &var) {
+            p = get_point_in_Dsphere<RNGType, Point>(var.n, B.radius(), var.rng);
+        }
+    };
+};
+
+
+#endif
@@ -0,0 +1,122 @@
+// VolEsti (volume computation and sampling library)
+
+// Copyright (c) 20012-2019 Vissarion Fisikopoulos
+// Copyright (c) 2018-2019 Apostolos Chalkis
+
+// Licensed under GNU LGPL.3, see LICENCE file
+
+#ifndef RNG_STREAMS_H
+#define RNG_STREAMS_H
+
+#include <stdint.h>
+
+
+// SplitMix64 step. It is used to spread a user seed over the state of a generator
+inline uint64_t splitmix64(uint64_t &x) {
+    uint64_t z = (x += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+
+// xoshiro256** generator from D. Blackman and S. Vigna, "Scrambled linear pseudorandom number generators", 2018.
+// The state is four 64-bit words, so copying it is cheap, and jump() advances the state by 2^128 steps.
+// It can be used as RNGType in vars and vars_g.
+class xoshiro256ss {
+public:
+    typedef uint64_t result_type;
+
+    xoshiro256ss(result_type s = 5489u) {
+        seed(s);
+    }
+
+    void seed(result_type s) {
+        uint64_t x = s;
+        for (int i = 0; i < 4; ++i) state[i] = splitmix64(x);
+    }
+
+    static result_type min() {
+        return 0;
+    }
+
+    static result_type max() {
+        return UINT64_MAX;
+    }
+
+    result_type operator()() {
+        const uint64_t result = rotl(state[1] * 5, 7) * 9;
+        const uint64_t t = state[1] << 17;
+
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = rotl(state[3], 45);
+
+        return result;
+    }
+
+    // equivalent to 2^128 calls to operator(); generates 2^128 non-overlapping subsequences
+    void jump() {
+        static const uint64_t JUMP[] = { 0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL,
+                                         0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL };
+        uint64_t s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+
+        for (int i = 0; i < 4; ++i) {
+            for (int b = 0; b < 64; ++b) {
+                if (JUMP[i] & (uint64_t(1) << b)) {
+                    s0 ^= state[0];
+                    s1 ^= state[1];
+                    s2 ^= state[2];
+                    s3 ^= state[3];
+                }
+                operator()();
+            }
+        }
+        state[0] = s0;
+        state[1] = s1;
+        state[2] = s2;
+        state[3] = s3;
+    }
+
+private:
+    uint64_t state[4];
+
+    static uint64_t rotl(const uint64_t x, int k) {
+        return (x << k) | (x >> (64 - k));
+    }
+};
+
+
+// Return the generator of the stream-th chain that is derived from seed.
+// Each (seed, stream) pair is hashed to a different seed of RNGType.
+template <typename RNGType>
+struct rng_stream {
+    static RNGType get(const uint64_t &seed, const unsigned int &stream) {
+        uint64_t x = seed ^ (0xD1B54A32D192ED03ULL * (uint64_t(stream) + 1));
+        splitmix64(x);
+        return RNGType(typename RNGType::result_type(splitmix64(x)));
+    }
+};
+
+
+// For xoshiro256** the streams are consecutive jumps of the generator seeded with seed
+template <>
+struct rng_stream<xoshiro256ss> {
+    static xoshiro256ss get(const uint64_t &seed, const unsigned int &stream) {
+        xoshiro256ss rng(seed);
+        for (unsigned int i = 0; i < stream; ++i) rng.jump();
+        return rng;
+    }
+};
+
+
+template <typename RNGType>
+RNGType get_rng_stream(const uint64_t &seed, const unsigned int &stream) {
+    return rng_stream<RNGType>::get(seed, stream);
+}
+
+
+#endif
@@ -10,17 +10,19 @@
 #ifndef RANDOM_SAMPLERS_H
 #define RANDOM_SAMPLERS_H
 
+#include "rng_streams.h"
+#include "direction_generator.h"
+#include "point_store.h"
+#include "parallel_tasks.h"
+
 
 // Pick a random direction as a normilized vector
 template <typename RNGType, typename Point, typename NT>
-Point get_direction(const unsigned int dim) {
+Point get_direction(const unsigned int dim, RNGType &rng) {
 
     boost::normal_distribution<> rdist(0,1);
     std::vector<NT> Xs(dim,0);
     NT normal = NT(0);
-    unsigned seed = std::chrono::system_clock::now().time_since_epoch().count();
-    RNGType rng(seed);
-    //RNGType rng2 = var.rng;
     for (unsigned int i=0; i<dim; i++) {
         Xs[i] = rdist(rng);
         normal += Xs[i] * Xs[i];
@@ -37,8 +39,8 @@ Point get_direction(const unsigned int dim) {
 
 // Pick a random point from a d-sphere
 template <typename RNGType, typename Point, typename NT>
-Point get_point_on_Dsphere(const unsigned int dim, const NT &radius){
-    Point p = get_direction<RNGType, Point, NT>(dim);
+Point get_point_on_Dsphere(const unsigned int dim, const NT &radius, RNGType &rng){
+    Point p = get_direction<RNGType, Point, NT>(dim, rng);
     p = (radius == 0) ? p : radius * p;
     return p;
 }
@@ -46,28 +48,32 @@ Point get_point_on_Dsphere(const unsigned int dim, const NT &radius){
 
 // Pick a random point from a d-ball
 template <typename RNGType, typename Point, typename NT>
-Point get_point_in_Dsphere(const unsigned int dim, const NT &radius){
+Point get_point_in_Dsphere(const unsigned int dim, const NT &radius, RNGType &rng){
 
     boost::random::uniform_real_distribution<> urdist(0,1);
     NT U;
-    unsigned seed = std::chrono::system_clock::now().time_since_epoch().count();
-    RNGType rng2(seed);
-    Point p = get_direction<RNGType, Point, NT>(dim);
-    U = urdist(rng2);
+    Point p = get_direction<RNGType, Point, NT>(dim, rng);
+    U = urdist(rng);
     U = std::pow(U, 1.0/(NT(dim)));
     p = (radius*U)*p;
     return p;
 }
 
 // ball walk with uniform target distribution
-template <typename RNGType, typename Point, typename Polytope, typename NT>
+// y is a point of the same dimension as p that is used as workspace
+template <typename Point, typename Polytope, typename NT, typename Parameters>
 void ball_walk(Point &p,
                Polytope &P,
-               const NT &delta)
+               const NT &delta,
+               Point &y,
+               const Parameters &var)
 {
-    //typedef typename Parameters::RNGType RNGType;
-    Point y = get_point_in_Dsphere<RNGType, Point>(p.dimension(), delta);
-    y = y + p;
+    boost::random::uniform_real_distribution<> urdist(0,1);
+    var.dirs.next(y, var.rng);
+    NT r = delta * std::pow(NT(urdist(var.rng)), 1.0/(NT(p.dimension())));
+
+    y *= r;
+    y += p;
     if (P.is_in(y)==-1) p = y;
 }
 
@@ -101,6 +107,9 @@ int birk_sym(T &P, K &randPoints, Point &p) {
 
 // ----- RANDOM POINT GENERATION FUNCTIONS ------------ //
 
+// the walks use the functions above
+#include "random_walks.h"
+
 template <typename Polytope, typename PointList, typename Parameters, typename Point>
 void boundary_rand_point_generator(Polytope &P,
                                    Point &p,   // a point to start
@@ -129,10 +138,10 @@ void boundary_rand_point_generator(Polytope &P,
         p_prev = p;
         p.set_coord(rand_coord, p[rand_coord] + bpair.first + kapa * (bpair.second - bpair.first));
     } else{
-        v = get_direction<RNGType, Point, NT>(n);
+        var.dirs.next(v, rng);
         std::pair <NT, NT> bpair = P.line_intersect(p, v, lamdas, Av);
         lambda = urdist(rng) * (bpair.first - bpair.second) + bpair.second;
-        p = (lambda * v) + p;
+        p.axpy(lambda, v);
     }
     //hit_and_run(p, P, var);
 
@@ -153,12 +162,14 @@ void boundary_rand_point_generator(Polytope &P,
 
             } else {
 
-                v = get_direction<RNGType, Point, NT>(n);
+                var.dirs.next(v, rng);
                 std::pair <NT, NT> bpair = P.line_intersect(p, v, lamdas, Av, lambda);
-                p1 = (bpair.first * v) + p;
-                p2 = (bpair.second * v) + p;
+                p1 = p;
+                p1.axpy(bpair.first, v);
+                p2 = p;
+                p2.axpy(bpair.second, v);
                 lambda = urdist(rng) * (bpair.first - bpair.second) + bpair.second;
-                p = (lambda * v) + p;
+                p.axpy(lambda, v);
 
             }
         }
@@ -169,7 +180,9 @@ void boundary_rand_point_generator(Polytope &P,
 }
 
 
-template <typename Polytope, typename PointList, typename Parameters, typename Point>
+// Sample rnum points with the random walk WalkPolicy (see random_walks.h).
+// Every point is stored after walk_len steps from the previous one.
+template <typename WalkPolicy, typename Polytope, typename PointList, typename Parameters, typename Point>
 void rand_point_generator(Polytope &P,
                          Point &p,   // a point to start
                          const unsigned int rnum,
@@ -177,63 +190,17 @@ void rand_point_generator(Polytope &P,
                          PointList &randPoints,
                          const Parameters &var)  // constants for volume
 {
-    typedef typename Parameters::RNGType RNGType;
-    typedef typename Point::FT NT;
-    unsigned int n = var.n;
-    RNGType &rng = var.rng; 
-    boost::random::uniform_real_distribution<> urdist(0, 1);
-    boost::random::uniform_int_distribution<> uidist(0, n - 1);
-
-    std::vector <NT> lamdas(P.num_of_hyperplanes(), NT(0)), Av(P.num_of_hyperplanes(), NT(0));
-    unsigned int rand_coord, rand_coord_prev;
-    NT kapa, ball_rad = var.delta, lambda;
-    Point p_prev = p, v(n);
-
-    if (var.ball_walk) {
-        ball_walk <RNGType> (p, P, ball_rad);
-    }else if (var.cdhr_walk) {//Compute the first point for the CDHR
-        rand_coord = uidist(rng);
-        kapa = urdist(rng);
-        std::pair <NT, NT> bpair = P.line_intersect_coord(p, rand_coord, lamdas);
-        p_prev = p;
-        p.set_coord(rand_coord, p[rand_coord] + bpair.first + kapa * (bpair.second - bpair.first));
-    } else if (var.rdhr_walk) {
-        v = get_direction<RNGType, Point, NT>(n);
-        std::pair <NT, NT> bpair = P.line_intersect(p, v, lamdas, Av);
-        lambda = urdist(rng) * (bpair.first - bpair.second) + bpair.second;
-        p = (lambda * v) + p;
-        //hit_and_run(p, P, var);
-    } else {
-        billiard_walk(P, p, var.diameter, lamdas, Av, lambda, var, true);
-    }
+    typename WalkPolicy::template Walk<Polytope, Point, Parameters> walk(P, p, var);
 
     for (unsigned int i = 1; i <= rnum; ++i) {
-        for (unsigned int j = 0; j < walk_len; ++j) {
-            if (var.ball_walk) {
-                ball_walk<RNGType>(p, P, ball_rad);
-            }else if (var.cdhr_walk) {
-                rand_coord_prev = rand_coord;
-                rand_coord = uidist(rng);
-                kapa = urdist(rng);
-                hit_and_run_coord_update(p, p_prev, P, rand_coord, rand_coord_prev, kapa, lamdas);
-            } else if (var.rdhr_walk) {
-                v = get_direction<RNGType, Point, NT>(n);
-                std::pair <NT, NT> bpair = P.line_intersect(p, v, lamdas, Av, lambda);
-                lambda = urdist(rng) * (bpair.first - bpair.second) + bpair.second;
-                p = (lambda * v) + p;
-                //hit_and_run(p, P, var);
-            } else {
-                billiard_walk(P, p, var.diameter, lamdas, Av, lambda,  var);
-            }
-        }
+        walk.apply(P, p, walk_len, var);
         randPoints.push_back(p);
     }
- 
 }
 
 
-
-template <typename BallPoly, typename PointList, typename Parameters, typename Point>
+// Sample rnum points in PBLarge and keep only the ones that lie in the ball of PBSmall
+template <typename WalkPolicy, typename BallPoly, typename PointList, typename Parameters, typename Point>
 void rand_point_generator(BallPoly &PBLarge,
                          Point &p,   // a point to start
                          const unsigned int rnum,
@@ -243,55 +210,10 @@ void rand_point_generator(BallPoly &PBLarge,
                          unsigned int &nump_PBSmall,
                          const Parameters &var) {  // constants for volume
 
-    typedef typename Point::FT NT;
-    typedef typename Parameters::RNGType RNGType;
-    unsigned int n = var.n;
-    RNGType &rng = var.rng;
-    boost::random::uniform_real_distribution<> urdist(0, 1);
-    boost::random::uniform_int_distribution<> uidist(0, n - 1);
-    std::vector <NT> lamdas(PBLarge.num_of_hyperplanes(), NT(0)), Av(PBLarge.num_of_hyperplanes(), NT(0));
-    unsigned int rand_coord, rand_coord_prev;
-    NT kapa, ball_rad = var.delta, lambda;
-    Point p_prev = p, v(n);
-
-    if (var.ball_walk) {
-        ball_walk<RNGType>(p, PBLarge, ball_rad);
-    }else if (var.cdhr_walk) {//Compute the first point for the CDHR
-        rand_coord = uidist(rng);
-        kapa = urdist(rng);
-        
-        std::pair <NT, NT> bpair = PBLarge.line_intersect_coord(p, rand_coord, lamdas);
-        p_prev = p;
-        p.set_coord(rand_coord, p[rand_coord] + bpair.first + kapa * (bpair.second - bpair.first));
-    } else if (var.rdhr_walk) {
-        v = get_direction<RNGType, Point, NT>(n);
-        std::pair <NT, NT> bpair = PBLarge.line_intersect(p, v, lamdas, Av);
-        lambda = urdist(rng) * (bpair.first - bpair.second) + bpair.second;
-        p = (lambda * v) + p;
-        //hit_and_run(p, PBLarge, var);
-    } else {
-        billiard_walk(PBLarge, p, var.diameter, lamdas, Av, lambda, var, true);
-    }
+    typename WalkPolicy::template Walk<BallPoly, Point, Parameters> walk(PBLarge, p, var);
 
     for (unsigned int i = 1; i <= rnum; ++i) {
-        for (unsigned int j = 0; j < walk_len; ++j) {
-            if (var.ball_walk) {
-                ball_walk<RNGType>(p, PBLarge, ball_rad);
-            }else if (var.cdhr_walk) {
-                rand_coord_prev = rand_coord;
-                rand_coord = uidist(rng);
-                kapa = urdist(rng);
-                hit_and_run_coord_update(p, p_prev, PBLarge, rand_coord, rand_coord_prev, kapa, lamdas);
-            } else if (var.rdhr_walk) {
-                v = get_direction<RNGType, Point, NT>(n);
-                std::pair <NT, NT> bpair = PBLarge.line_intersect(p, v, lamdas, Av, lambda);
-                lambda = urdist(rng) * (bpair.first - bpair.second) + bpair.second;
-                p = (lambda * v) + p;
-                //hit_and_run(p, PBLarge, var);
-            } else {
-                billiard_walk(PBLarge, p, var.diameter, lamdas, Av, lambda, var);
-            }
-        }
+        walk.apply(PBLarge, p, walk_len, var);
         if (PBSmall.second().is_in(p) == -1) {//is in
             randPoints.push_back(p);
             ++nump_PBSmall;
@@ -299,111 +221,165 @@ void rand_point_generator(BallPoly &PBLarge,
     }
 }
 
-template <typename Polytope, typename Point, typename Parameters, typename NT>
-void uniform_first_point(Polytope &P,
-                         Point &p,   // a point to start
-                         Point &p_prev, // previous point
-                         unsigned int &coord_prev, // previous coordinate ray
-                         unsigned int walk_len, // number of steps for the random walk
-                         std::vector<NT> &lamdas,
-                         std::vector<NT> &Av,
-                         NT &lambda,
-                         const Parameters &var) {
-    typedef typename Parameters::RNGType RNGType;
-    unsigned int n = var.n, rand_coord;
-    NT kapa, ball_rad = var.delta;
-    Point v(n);
-    boost::random::uniform_int_distribution<> uidist(0, n - 1);
-    boost::random::uniform_real_distribution<> urdist(0, 1);
-    unsigned seed = std::chrono::system_clock::now().time_since_epoch().count();
-    RNGType rng(seed);
 
+// The following two generators select the random walk from the flags of var
+// and call the corresponding specialization above.
+template <typename Polytope, typename PointList, typename Parameters, typename Point>
+void rand_point_generator(Polytope &P,
+                         Point &p,   // a point to start
+                         const unsigned int rnum,
+                         const unsigned int walk_len,
+                         PointList &randPoints,
+                         const Parameters &var)  // constants for volume
+{
     if (var.ball_walk) {
-        ball_walk<RNGType>(p, P, ball_rad);
-    } else if (var.cdhr_walk) {//Compute the first point for the CDHR
-        rand_coord = uidist(rng);
-        kapa = urdist(rng);
-        std::pair <NT, NT> bpair = P.line_intersect_coord(p, rand_coord, lamdas);
-        p_prev = p;
-        p.set_coord(rand_coord, p[rand_coord] + bpair.first + kapa * (bpair.second - bpair.first));
-        coord_prev = rand_coord;
+        rand_point_generator<BallWalk>(P, p, rnum, walk_len, randPoints, var);
+    } else if (var.cdhr_walk) {
+        rand_point_generator<CDHRWalk>(P, p, rnum, walk_len, randPoints, var);
     } else if (var.rdhr_walk) {
-        v = get_direction<RNGType, Point, NT>(n);
-        std::pair <NT, NT> bpair = P.line_intersect(p, v, lamdas, Av);
-        lambda = urdist(rng) * (bpair.first - bpair.second) + bpair.second;
-        p = (lambda * v) + p;
+        rand_point_generator<RDHRWalk>(P, p, rnum, walk_len, randPoints, var);
     } else {
-        billiard_walk(P, p, var.diameter, lamdas, Av, lambda, var, true);
+        rand_point_generator<BilliardWalk>(P, p, rnum, walk_len, randPoints, var);
     }
-    walk_len--;
+}
 
 
+template <typename BallPoly, typename PointList, typename Parameters, typename Point>
+void rand_point_generator(BallPoly &PBLarge,
+                         Point &p,   // a point to start
+                         const unsigned int rnum,
+                         const unsigned int walk_len,
+                         PointList &randPoints,
+                         const BallPoly &PBSmall,
+                         unsigned int &nump_PBSmall,
+                         const Parameters &var) {  // constants for volume
+
     if (var.ball_walk) {
-        for (unsigned int j = 0; j < walk_len; j++) {
-            ball_walk<RNGType>(p, P, ball_rad);
-        }
+        rand_point_generator<BallWalk>(PBLarge, p, rnum, walk_len, randPoints, PBSmall, nump_PBSmall, var);
     } else if (var.cdhr_walk) {
-        for (unsigned int j = 0; j < walk_len; j++) {
-            rand_coord = uidist(rng);
-            kapa = urdist(rng);
-            hit_and_run_coord_update(p, p_prev, P, rand_coord, coord_prev, kapa, lamdas);
-            coord_prev = rand_coord;
-        }
+        rand_point_generator<CDHRWalk>(PBLarge, p, rnum, walk_len, randPoints, PBSmall, nump_PBSmall, var);
     } else if (var.rdhr_walk) {
-        for (unsigned int j = 0; j < walk_len; j++) {
-            v = get_direction<RNGType, Point, NT>(n);
-            std::pair <NT, NT> bpair = P.line_intersect(p, v, lamdas, Av, lambda);
-            lambda = urdist(rng) * (bpair.first - bpair.second) + bpair.second;
-            p = (lambda * v) + p;
-        }
+        rand_point_generator<RDHRWalk>(PBLarge, p, rnum, walk_len, randPoints, PBSmall, nump_PBSmall, var);
     } else {
-        billiard_walk(P, p, var.diameter, lamdas, Av, lambda, var);
+        rand_point_generator<BilliardWalk>(PBLarge, p, rnum, walk_len, randPoints, PBSmall, nump_PBSmall, var);
+    }
+}
+
+// Sample rnum points with min(var.n_threads, rnum) independent chains that start from p and run in parallel.
+// sample_chain(Q, q, num, points, vark) stores in points num points of one chain that starts from q, where
+// Q is a copy of P owned by the thread and vark a copy of var with the random stream of the chain; the
+// streams are derived from one seed drawn from var.rng. The points of the k-th chain form the k-th contiguous
+// block of randPoints, so the batches of the statistical tests on randPoints are parts of single chains.
+// p is set to the last point of the last chain.
+template <typename Polytope, typename Point, typename PointList, typename Parameters, typename ChainSampler>
+void sample_parallel_chains(Polytope &P, Point &p, const unsigned int rnum, PointList &randPoints,
+                            const Parameters &var, ChainSampler sample_chain)
+{
+    typedef typename Parameters::RNGType RNGType;
+    const unsigned int chains = std::min(var.n_threads, rnum);
+
+    std::vector<Polytope> polys(chains, P);
+    std::vector<RNGType> rngs;
+    std::vector<Parameters> vars_t;
+    std::vector<std::vector<Point> > points(chains);
+    std::vector<Point> last(chains, p);
+    rngs.reserve(chains);
+    vars_t.reserve(chains);
+    const uint64_t base_seed = var.rng();
+    for (unsigned int k = 0; k < chains; ++k) rngs.push_back(get_rng_stream<RNGType>(base_seed, k));
+    for (unsigned int k = 0; k < chains; ++k) vars_t.push_back(Parameters(var, rngs[k]));
+
+    run_tasks(chains, chains, [&](const unsigned int k, const unsigned int t) {
+        const unsigned int num = rnum / chains + (k < rnum % chains ? 1 : 0);
+        points[k].reserve(num);
+        sample_chain(polys[t], last[k], num, points[k], vars_t[k]);
+    });
+
+    for (unsigned int k = 0; k < chains; ++k) {
+        for (unsigned int i = 0; i < points[k].size(); ++i) randPoints.push_back(points[k][i]);
     }
+    p = last[chains - 1];
 }
 
 
+// Sample rnum points with var.n_threads parallel chains of the random walk that is selected by the flags of var
+// (see sample_parallel_chains). With one thread this is rand_point_generator.
+template <typename Polytope, typename PointList, typename Parameters, typename Point>
+void parallel_rand_point_generator(Polytope &P,
+                                   Point &p,   // a point to start
+                                   const unsigned int rnum,
+                                   const unsigned int walk_len,
+                                   PointList &randPoints,
+                                   const Parameters &var)
+{
+    if (var.n_threads <= 1 || rnum <= 1) {
+        rand_point_generator(P, p, rnum, walk_len, randPoints, var);
+        return;
+    }
+    sample_parallel_chains(P, p, rnum, randPoints, var, [walk_len](Polytope &Q, Point &q, const unsigned int num,
+            std::vector<Point> &points, const Parameters &vark) {
+        rand_point_generator(Q, q, num, walk_len, points, vark);
+    });
+}
+
 
-template <typename Polytope, typename Point, typename Parameters, typename NT>
-void uniform_next_point(Polytope &P,
-                        Point &p,   // a point to start
-                        Point &p_prev, // previous point
-                        unsigned int &coord_prev, // previous coordinate ray
-                        const unsigned int walk_len, // number of steps for the random walk
-                        std::vector<NT> &lamdas,
-                        std::vector<NT> &Av,
-                        NT &lambda,
-                        const Parameters &var) {
+// Advance K = chains.size() hit-and-run chains with random directions in lockstep.
+// Each step computes A*[v_1 ... v_K] with one matrix-matrix product (see the block line_intersect of
+// HPolytope and BallIntersectPolytope), so the matrix of the polytope is read once per step for all the chains.
+// After every walk_len steps the K current points are stored in randPoints until rnum points are stored.
+// The chains are updated to their last points.
+template <typename Polytope, typename PointList, typename Parameters, typename Point>
+void batch_rand_point_generator(Polytope &P,
+                                std::vector<Point> &chains, // the starting points of the chains
+                                const unsigned int rnum,
+                                const unsigned int walk_len,
+                                PointList &randPoints,
+                                const Parameters &var)
+{
     typedef typename Parameters::RNGType RNGType;
-    unsigned int n = var.n, rand_coord;
-    boost::random::uniform_int_distribution<> uidist(0, n - 1);
+    typedef typename Point::FT NT;
+    typedef typename Polytope::MT MT;
+    typedef typename Polytope::VT VT;
+    unsigned int n = var.n, K = chains.size(), num = 0;
+    RNGType &rng = var.rng;
     boost::random::uniform_real_distribution<> urdist(0, 1);
-    unsigned seed = std::chrono::system_clock::now().time_since_epoch().count();
-    RNGType rng(seed);
-    NT ball_rad = var.delta, kapa;
+
+    MT R(n, K), V(n, K), AR, AV;
+    VT min_plus(K), max_minus(K), lambdas(K);
     Point v(n);
 
+    for (unsigned int k = 0; k < K; ++k) R.col(k) = Eigen::Map<const VT>(chains[k].data(), n);
 
-    if (var.ball_walk) {
-        for (unsigned int j = 0; j < walk_len; j++) ball_walk<RNGType>(p, P, ball_rad);
-    } else if (var.rdhr_walk) {
-        for (unsigned int j = 0; j < walk_len; j++) {
-            v = get_direction<RNGType, Point, NT>(n);
-            std::pair <NT, NT> bpair = P.line_intersect(p, v, lamdas, Av, lambda);
-            lambda = urdist(rng) * (bpair.first - bpair.second) + bpair.second;
-            p = (lambda * v) + p;
+    for (unsigned int k = 0; k < K; ++k) {
+        var.dirs.next(v, rng);
+        V.col(k) = Eigen::Map<const VT>(v.data(), n);
+    }
+    P.line_intersect(R, V, AR, AV, min_plus, max_minus);
+    for (unsigned int k = 0; k < K; ++k) lambdas(k) = urdist(rng) * (min_plus(k) - max_minus(k)) + max_minus(k);
+    R.noalias() += V * lambdas.asDiagonal();
+
+    while (num < rnum) {
+        for (unsigned int j = 0; j < walk_len; ++j) {
+            for (unsigned int k = 0; k < K; ++k) {
+                var.dirs.next(v, rng);
+                V.col(k) = Eigen::Map<const VT>(v.data(), n);
+            }
+            P.line_intersect(R, V, AR, AV, lambdas, min_plus, max_minus);
+            for (unsigned int k = 0; k < K; ++k) {
+                lambdas(k) = urdist(rng) * (min_plus(k) - max_minus(k)) + max_minus(k);
+            }
+            R.noalias() += V * lambdas.asDiagonal();
         }
-    } else if (var.bill_walk) {
-        for (unsigned int j = 0; j < walk_len; j++) billiard_walk(P, p, var.diameter, lamdas, Av, lambda, var);
-    }else {
-        for (unsigned int j = 0; j < walk_len; j++) {
-            rand_coord = uidist(rng);
-            kapa = urdist(rng);
-            hit_and_run_coord_update(p, p_prev, P, rand_coord, coord_prev, kapa, lamdas);
-            coord_prev = rand_coord;
+        for (unsigned int k = 0; k < K && num < rnum; ++k, ++num) {
+            Eigen::Map<VT>(v.data(), n) = R.col(k);
+            randPoints.push_back(v);
         }
     }
+
+    for (unsigned int k = 0; k < K; ++k) Eigen::Map<VT>(chains[k].data(), n) = R.col(k);
 }
 
+
 // ----- HIT AND RUN FUNCTIONS ------------ //
 /*
 //hit-and-run with random directions and update
@@ -417,7 +393,8 @@ void hit_and_run(Point &p,
     RNGType &rng = var.rng;
     boost::random::uniform_real_distribution<> urdist(0, 1);
 
-    Point v = get_direction<RNGType, Point, NT>(n);
+    Point v(n);
+    var.dirs.next(v, rng);
     std::pair <NT, NT> bpair = P.line_intersect(p, v);
     //NT lambda = urdist(rng) * (bpair.first - bpair.second) + bpair.second;
     p = (( urdist(rng) * (bpair.first - bpair.second) + bpair.second) * v) + p;
@@ -440,9 +417,10 @@ void hit_and_run_coord_update(Point &p,
 }
 
 
+// v and p0 are points of the same dimension as p that are used as workspace
 template <class ConvexBody, class Point, class Parameters, typename NT>
 void billiard_walk(ConvexBody &P, Point &p, NT diameter, std::vector<NT> &Ar, std::vector<NT> &Av, NT &lambda_prev,
-                   Parameters &var, bool first = false) {
+                   Point &v, Point &p0, Parameters &var, bool first = false) {
 
     typedef typename Parameters::RNGType RNGType;
     unsigned int n = P.dimension();
@@ -450,19 +428,20 @@ void billiard_walk(ConvexBody &P, Point &p, NT diameter, std::vector<NT> &Ar, st
     boost::random::uniform_real_distribution<> urdist(0, 1);
     NT T = urdist(rng) * diameter;
     const NT dl = 0.995;
-    Point v = get_direction<RNGType, Point, NT>(n), p0 = p;
+    p0 = p;
+    var.dirs.next(v, rng);
     int it = 0;
 
     if (first) {
 
         std::pair<NT, int> pbpair = P.line_positive_intersect(p, v, Ar, Av);
         if (T <= pbpair.first) {
-            p = (T * v) + p;
+            p.axpy(T, v);
             lambda_prev = T;
             return;
         }
         lambda_prev = dl * pbpair.first;
-        p = (lambda_prev * v) + p;
+        p.axpy(lambda_prev, v);
         T -= lambda_prev;
         P.compute_reflection(v, p, pbpair.second);
     }
@@ -471,13 +450,13 @@ void billiard_walk(ConvexBody &P, Point &p, NT diameter, std::vector<NT> &Ar, st
 
         std::pair<NT, int> pbpair = P.line_positive_intersect(p, v, Ar, Av, lambda_prev);
         if (T <= pbpair.first) {
-            p = (T * v) + p;
+            p.axpy(T, v);
             lambda_prev = T;
             break;
         }
 
         lambda_prev = dl * pbpair.first;
-        p = (lambda_prev * v) + p;
+        p.axpy(lambda_prev, v);
         T -= lambda_prev;
         P.compute_reflection(v, p, pbpair.second);
         it++;
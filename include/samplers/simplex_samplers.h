@@ -21,16 +21,23 @@
 #ifndef SIMPLEX_SAMPLERS_H
 #define SIMPLEX_SAMPLERS_H
 
-template <typename NT, typename RNGType, typename Point>
-void Sam_Unit(unsigned int dim, unsigned int num, std::list<Point> &points){
+template <typename NT, typename RNGType, typename PointList>
+void Sam_Unit(unsigned int dim, unsigned int num, PointList &points,
+              double seed = std::numeric_limits<double>::signaling_NaN()){
+
+    typedef typename PointList::value_type Point;
 
     unsigned int j,i,x_rand,M=2147483647,pr,divisors,pointer;  // M is the largest possible integer
     std::vector<unsigned int> x_vec;
     std::vector<NT> y;
 
     boost::random::uniform_int_distribution<> uidist(1,M);
-    unsigned seed = std::chrono::system_clock::now().time_since_epoch().count();
-    RNGType rng(seed);
+    unsigned rng_seed = std::chrono::system_clock::now().time_since_epoch().count();
+    RNGType rng(rng_seed);
+    if (!std::isnan(seed)) {
+        unsigned rng_seed = seed;
+        rng.seed(rng_seed);
+    }
 
     if (dim<=60){
 
@@ -153,8 +160,11 @@ void Sam_Unit(unsigned int dim, unsigned int num, std::list<Point> &points){
 
 }
 
-template <typename NT, typename RNGType, typename Point>
-void Sam_Canon_Unit(unsigned int dim, unsigned int num, std::list<Point> &points){
+template <typename NT, typename RNGType, typename PointList>
+void Sam_Canon_Unit(unsigned int dim, unsigned int num, PointList &points,
+                    double seed = std::numeric_limits<double>::signaling_NaN()){
+
+    typedef typename PointList::value_type Point;
 
     unsigned int j,i,x_rand,M=2147483647,pointer;  // M is the largest possible integer
     //std::vector<int> x_vec;
@@ -162,8 +172,12 @@ void Sam_Canon_Unit(unsigned int dim, unsigned int num, std::list<Point> &points
     dim--;
     boost::random::uniform_int_distribution<> uidist(1,M);
 
-    unsigned seed = std::chrono::system_clock::now().time_since_epoch().count();
-    RNGType rng(seed);
+    unsigned rng_seed = std::chrono::system_clock::now().time_since_epoch().count();
+    RNGType rng(rng_seed);
+    if (!std::isnan(seed)) {
+        unsigned rng_seed = seed;
+        rng.seed(rng_seed);
+    }
 
     std::vector<NT> x_vec2;
     NT Ti,sum;
@@ -201,7 +215,8 @@ void Sam_Canon_Unit(unsigned int dim, unsigned int num, std::list<Point> &points
 
 //Owen mapping for sample from an arbitrary simplex given in V-represantation
 template <typename Vpolytope, typename PointList>
-void Sam_arb_simplex(const Vpolytope &P, unsigned int num, PointList &points){
+void Sam_arb_simplex(const Vpolytope &P, unsigned int num, PointList &points,
+                     double seed = std::numeric_limits<double>::signaling_NaN()){
 
     typedef typename Vpolytope::MT MT;
     typedef typename Vpolytope::NT NT;
@@ -229,8 +244,12 @@ void Sam_arb_simplex(const Vpolytope &P, unsigned int num, PointList &points){
     Point p0=*it_beg;
 
     boost::random::uniform_int_distribution<> uidist(1,M);
-    unsigned seed = std::chrono::system_clock::now().time_since_epoch().count();
-    RNGType rng(seed);
+    unsigned rng_seed = std::chrono::system_clock::now().time_since_epoch().count();
+    RNGType rng(rng_seed);
+    if (!std::isnan(seed)) {
+        unsigned rng_seed = seed;
+        rng.seed(rng_seed);
+    }
 
     if (dim<=60){
 
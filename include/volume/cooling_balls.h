@@ -11,6 +11,7 @@
 #include "hpolytope.h"
 #include "vpolytope.h"
 #include "zpolytope.h"
+#include "zonotope_facets.h"
 #include "ballintersectconvex.h"
 #include "vpolyintersectvpoly.h"
 #include "samplers.h"
@@ -19,6 +20,7 @@
 #include <boost/math/special_functions/erf.hpp>
 #include "ball_annealing.h"
 #include "ratio_estimation.h"
+#include "parallel_tasks.h"
 
 template <typename Polytope, typename Point, typename UParameters, typename AParameters, typename NT>
 NT vol_cooling_balls(Polytope &P, UParameters &var, AParameters &var_ban, std::pair<Point,NT> &InnerBall) {
@@ -27,7 +29,6 @@ NT vol_cooling_balls(Polytope &P, UParameters &var, AParameters &var_ban, std::p
     typedef BallIntersectPolytope <Polytope, ball> PolyBall;
     typedef typename UParameters::RNGType RNGType;
     typedef typename Polytope::VT VT;
-    typedef std::list <Point> PointList;
 
     int n = var.n, win_len = var_ban.win_len, N = var_ban.N, nu = var_ban.nu;
     bool verbose = var.verbose, round = var.round, window2 = var_ban.window2;
@@ -65,7 +66,7 @@ NT vol_cooling_balls(Polytope &P, UParameters &var, AParameters &var_ban, std::p
     // Save the radius of the Chebychev ball
     var.che_rad = radius;
     // Move the chebychev center to the origin and apply the same shifting to the polytope
-    VT c_e = Eigen::Map<VT>(&c.get_coeffs()[0], c.dimension());
+    VT c_e = c.map();
     P.shift(c_e);
 
     if ( !get_sequence_of_polyballs<PolyBall, RNGType>(P, BallSet, ratios, N * nu, nu, lb, ub, radius, alpha, var, rmax) ){
@@ -79,31 +80,71 @@ NT vol_cooling_balls(Polytope &P, UParameters &var, AParameters &var_ban, std::p
     prob = std::pow(prob, 1.0 / NT(mm));
     NT er0 = e / (2.0 * std::sqrt(NT(mm))), er1 = (e * std::sqrt(4.0 * NT(mm) - 1)) / (2.0 * std::sqrt(NT(mm)));
 
-    vol *= (window2) ? esti_ratio<RNGType, Point>(*(BallSet.end() - 1), P, *(ratios.end() - 1), er0, win_len, 1200, var,
-            true, (*(BallSet.end() - 1)).radius()) :
-           esti_ratio_interval<RNGType, Point>(*(BallSet.end() - 1), P, *(ratios.end() - 1), er0, win_len, 1200, prob,
-                                               var, true, (*(BallSet.end() - 1)).radius());
-
-    PolyBall Pb;
-    typename std::vector<ball>::iterator balliter = BallSet.begin();
-    typename std::vector<NT>::iterator ratioiter = ratios.begin();
-
     er1 = er1 / std::sqrt(NT(mm) - 1.0);
 
-    if (*ratioiter != 1) vol *= (!window2) ? 1 / esti_ratio_interval<RNGType, Point>(P, *balliter, *ratioiter, er1,
-            win_len, N * nu, prob, var) : 1 / esti_ratio<RNGType, Point>(P, *balliter, *ratioiter, er1, win_len, N * nu,
-                                                                         var);
-    for ( ; balliter < BallSet.end() - 1; ++balliter, ++ratioiter) {
-        Pb = PolyBall(P, *balliter);
-        Pb.comp_diam(var.diameter, 0.0);
-        vol *= (!window2) ? 1 / esti_ratio_interval<RNGType, Point>(Pb, *(balliter + 1), *(ratioiter + 1), er1,
-                win_len, N * nu, prob, var) : 1 / esti_ratio<RNGType, Point>(Pb, *balliter, *ratioiter, er1,
-                                                                             win_len, N * nu, var);
+    // The ratios of consecutive bodies of the schedule are estimated independently: task 0 is the ratio
+    // of the largest ball to P, task 1 the ratio of P to the first ball and task i+2 the ratio of
+    // P \cap B_i to B_{i+1}. With n_threads > 1 the threads share the tasks (see run_tasks()); every
+    // thread has its own copy of P and every task its own random stream, derived from one seed drawn from
+    // var.rng, so the estimate does not depend on the number of threads.
+    const unsigned int num_tasks = BallSet.size() + 1, n_threads = std::max(var.n_threads, 1u);
+    std::vector<NT> estimates(num_tasks, NT(1));
+
+    auto estimate = [&](const unsigned int i, Polytope &Pt, UParameters &vart) {
+        if (i == 0) {
+            estimates[0] = (window2) ? esti_ratio<ExactBallSampler, Point>(BallSet.back(), Pt, ratios.back(), er0,
+                    win_len, 1200, vart) :
+                           esti_ratio_interval<ExactBallSampler, Point>(BallSet.back(), Pt, ratios.back(), er0,
+                                   win_len, 1200, prob, vart);
+        } else if (i == 1) {
+            if (ratios[0] != 1) estimates[1] = (!window2) ? 1 / esti_ratio_interval<Point>(Pt, BallSet[0], ratios[0],
+                    er1, win_len, N * nu, prob, vart) : 1 / esti_ratio<Point>(Pt, BallSet[0], ratios[0], er1, win_len,
+                                                                              N * nu, vart);
+        } else {
+            PolyBall Pb(Pt, BallSet[i - 2]);
+            Pb.comp_diam(vart.diameter, 0.0);
+            estimates[i] = (!window2) ? 1 / esti_ratio_interval<Point>(Pb, BallSet[i - 1], ratios[i - 1], er1,
+                    win_len, N * nu, prob, vart) : 1 / esti_ratio<Point>(Pb, BallSet[i - 1], ratios[i - 1], er1,
+                                                                         win_len, N * nu, vart);
+        }
+    };
+
+    if (n_threads == 1) {
+        for (unsigned int i = 0; i < num_tasks; ++i) estimate(i, P, var);
+    } else {
+        std::vector<Polytope> polys(std::min(n_threads, num_tasks), P);
+        std::vector<RNGType> rngs;
+        std::vector<UParameters> vars_t;
+        rngs.reserve(num_tasks);
+        vars_t.reserve(num_tasks);
+        const uint64_t base_seed = var.rng();
+        for (unsigned int i = 0; i < num_tasks; ++i) rngs.push_back(get_rng_stream<RNGType>(base_seed, i));
+        for (unsigned int i = 0; i < num_tasks; ++i) vars_t.push_back(UParameters(var, rngs[i]));
+
+        run_tasks(num_tasks, n_threads, [&](const unsigned int i, const unsigned int t) {
+            estimate(i, polys[t], vars_t[i]);
+        });
     }
 
+    for (unsigned int i = 0; i < num_tasks; ++i) vol *= estimates[i];
+
     P.free_them_all();
     return vol * round_value;
 
 }
 
+
+// a zonotope with few facets is replaced by its H-representation, so that no LP is solved
+template <typename Point, typename UParameters, typename AParameters, typename NT>
+NT vol_cooling_balls(Zonotope<Point> &P, UParameters &var, AParameters &var_ban, std::pair<Point,NT> &InnerBall) {
+
+    HPolytope<Point> HP;
+    if (zonotope_as_hpoly(P, HP, var.n_threads)) {
+        NT vol = vol_cooling_balls(HP, var, var_ban, InnerBall);
+        P.free_them_all();
+        return vol;
+    }
+    return vol_cooling_balls<Zonotope<Point>, Point, UParameters, AParameters, NT>(P, var, var_ban, InnerBall);
+}
+
 #endif
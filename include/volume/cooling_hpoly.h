@@ -10,6 +10,7 @@
 #include "hpoly_annealing.h"
 #include "ratio_estimation.h"
 #include "zonoIntersecthpoly.h"
+#include "zonotope_facets.h"
 
 
 template <typename Hpolytope, typename Zonotope, typename UParameters, typename AParameters, typename GParameters, typename Point, typename NT>
@@ -27,10 +28,17 @@ NT vol_cooling_hpoly (Zonotope &ZP, UParameters &var, AParameters &var_ban, GPar
   
     bool verbose = var.verbose, round = var.round, window2 = var_ban.window2;
 
+    // with few facets the zonotope itself is an H-polytope and there is no need for an enclosing one
+    Hpolytope HP0;
+    if (zonotope_as_hpoly(ZP, HP0, var.n_threads)) {
+        vol = vol_cooling_balls(HP0, var, var_ban, InnerB);
+        ZP.free_them_all();
+        return vol;
+    }
+
     MT V = ZP.get_mat();
     MT G = V.transpose();
     int m = G.cols();
-    std::list<Point> randPoints;
 
     MT XX(m, 2*m);
     XX << MT::Identity(m,m), -MT::Identity(m,m);
@@ -71,7 +79,7 @@ NT vol_cooling_hpoly (Zonotope &ZP, UParameters &var, AParameters &var_ban, GPar
     std::vector<NT> diams_inter;
 
     if ( !get_sequence_of_zonopolys<ZonoHP>(ZP, HP, HPolySet, Zs_max, ratios, N*nu, nu, lb, ub, alpha, var,
-            var3, diams_inter) ){
+            diams_inter) ){
         return -1.0;
     }
     var.diameter = diam0;
@@ -90,27 +98,27 @@ NT vol_cooling_hpoly (Zonotope &ZP, UParameters &var, AParameters &var_ban, GPar
         var2.cdhr_walk = true;
         var2.ball_walk = var2.rdhr_walk = var2.bill_walk = false;
         var2.walk_steps = 10+2*n;
-        vol *= esti_ratio_interval<RNGType, Point>(HP, ZP, ratio, er0, win_len, N*nu, prob, var2);
+        vol *= esti_ratio_interval<Point>(HP, ZP, ratio, er0, win_len, N*nu, prob, var2);
     } else {
-        vol *= esti_ratio<RNGType, Point>(HP, ZP, ratio, er0, var_g.W, N*nu, var);
+        vol *= esti_ratio<Point>(HP, ZP, ratio, er0, var_g.W, N*nu, var);
     }
 
     Hpolytope b1, b2;
     if (HPolySet.size()==0) {
         if (ratios[0]!=1) {
             if(!window2) {
-                vol = vol / esti_ratio_interval<RNGType, Point>(ZP, HP, ratios[0], er1, win_len, N*nu, prob, var);
+                vol = vol / esti_ratio_interval<Point>(ZP, HP, ratios[0], er1, win_len, N*nu, prob, var);
             } else {
-                vol = vol / esti_ratio<RNGType, Point>(ZP, HP, ratios[0], er1, var_g.W, N*nu, var);
+                vol = vol / esti_ratio<Point>(ZP, HP, ratios[0], er1, var_g.W, N*nu, var);
             }
         }
     } else {
         er1 = er1 / std::sqrt(NT(mm)-1.0);
         b1 = HPolySet[0];
         if(!window2) {
-            vol = vol / esti_ratio_interval<RNGType, Point>(ZP, b1, ratios[0], er1, win_len, N*nu, prob, var);
+            vol = vol / esti_ratio_interval<Point>(ZP, b1, ratios[0], er1, win_len, N*nu, prob, var);
         } else {
-            vol = vol / esti_ratio<RNGType, Point>(ZP, b1, ratios[0], er1, var_g.W, N*nu, var);
+            vol = vol / esti_ratio<Point>(ZP, b1, ratios[0], er1, var_g.W, N*nu, var);
         }
 
         for (int i = 0; i < HPolySet.size()-1; ++i) {
@@ -118,18 +126,18 @@ NT vol_cooling_hpoly (Zonotope &ZP, UParameters &var, AParameters &var_ban, GPar
             b2 = HPolySet[i+1];
             var.diameter = diams_inter[i];
             if(!window2) {
-                vol = vol / esti_ratio_interval<RNGType, Point>(zb1, b2, ratios[i], er1, win_len, N*nu, prob, var);
+                vol = vol / esti_ratio_interval<Point>(zb1, b2, ratios[i], er1, win_len, N*nu, prob, var);
             } else {
-                vol = vol / esti_ratio<RNGType, Point>(zb1, b2, ratios[i], er1, var_g.W, N*nu, var);
+                vol = vol / esti_ratio<Point>(zb1, b2, ratios[i], er1, var_g.W, N*nu, var);
             }
         }
 
         zb1 = ZonoHP(ZP,HPolySet[HPolySet.size()-1]);
         var.diameter = diams_inter[diams_inter.size()-1];
         if (!window2) {
-            vol = vol / esti_ratio_interval<RNGType, Point>(zb1, HP, ratios[ratios.size() - 1], er1, win_len, N*nu, prob, var);
+            vol = vol / esti_ratio_interval<Point>(zb1, HP, ratios[ratios.size() - 1], er1, win_len, N*nu, prob, var);
         } else {
-            vol = vol / esti_ratio<RNGType, Point>(zb1, HP, ratios[ratios.size() - 1], er1, var_g.W, N*nu, var);
+            vol = vol / esti_ratio<Point>(zb1, HP, ratios[ratios.size() - 1], er1, var_g.W, N*nu, var);
         }
     }
 
@@ -12,6 +12,8 @@
 #ifndef VARS_H
 #define VARS_H
 
+#include "direction_generator.h"
+
 //structs with variables and random generators
 template <typename NT, typename RNG>
 struct vars{
@@ -47,6 +49,14 @@ public:
             urdist(urdist), urdist1(urdist1) , delta(delta) , verbose(verbose), rand_only(rand_only), round(round),
             NN(NN),birk(birk), ball_walk(ball_walk), cdhr_walk(cdhr_walk), rdhr_walk(rdhr_walk), bill_walk(bill_walk){};
 
+    // copy the parameters of var and use the random generator rng (e.g. one for each thread)
+    vars(const vars &var, RNG &rng) :
+            m(var.m), n(var.n), walk_steps(var.walk_steps), n_threads(var.n_threads), err(var.err),
+            error(var.error), lw(var.lw), up(var.up), L(var.L), che_rad(var.che_rad), diameter(var.diameter),
+            rng(rng), urdist(var.urdist), urdist1(var.urdist1), delta(var.delta), verbose(var.verbose),
+            rand_only(var.rand_only), round(var.round), NN(var.NN), birk(var.birk), ball_walk(var.ball_walk),
+            cdhr_walk(var.cdhr_walk), rdhr_walk(var.rdhr_walk), bill_walk(var.bill_walk){};
+
     unsigned int m;
     unsigned int n;
     unsigned int walk_steps;
@@ -71,6 +81,8 @@ public:
     bool cdhr_walk;
     bool rdhr_walk;
     bool bill_walk;
+    // block buffer of random directions drawn from rng, shared by the walks that use these parameters
+    mutable DirectionGenerator<NT> dirs;
 };
 
 template <typename NT, typename RNG>
@@ -103,6 +115,13 @@ public:
             verbose(verbose), rand_only(rand_only), round(round),
             NN(NN),birk(birk),ball_walk(ball_walk),cdhr_walk(cdhr_walk), rdhr_walk(rdhr_walk){};
 
+    // copy the parameters of var and use the random generator rng (e.g. one for each thread)
+    vars_g(const vars_g &var, RNG &rng) :
+            n(var.n), walk_steps(var.walk_steps), N(var.N), W(var.W), n_threads(var.n_threads), error(var.error),
+            che_rad(var.che_rad), rng(rng), C(var.C), frac(var.frac), ratio(var.ratio), delta(var.delta),
+            verbose(var.verbose), rand_only(var.rand_only), round(var.round), NN(var.NN), birk(var.birk),
+            ball_walk(var.ball_walk), cdhr_walk(var.cdhr_walk), rdhr_walk(var.rdhr_walk){};
+
     unsigned int n;
     unsigned int walk_steps;
     unsigned int N;
@@ -123,6 +142,8 @@ public:
     bool ball_walk;
     bool cdhr_walk;
     bool rdhr_walk;
+    // block buffer of random directions drawn from rng, shared by the walks that use these parameters
+    mutable DirectionGenerator<NT> dirs;
 };
 
 
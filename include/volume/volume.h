@@ -17,9 +17,12 @@
 #include <list>
 #include <math.h>
 #include <chrono>
+#include <thread>
 #include "cartesian_geom/cartesian_kernel.h"
+#include "cartesian_geom/dimension_dispatch.h"
 #include "vars.h"
 #include "hpolytope.h"
+#include "sparse_hpolytope.h"
 #include "vpolytope.h"
 #include "zpolytope.h"
 #include "ball.h"
@@ -29,6 +32,162 @@
 #include "rounding.h"
 #include "gaussian_samplers.h"
 #include "gaussian_annealing.h"
+#include "parallel_tasks.h"
+
+
+// Estimate the volume of P with the sequence of balls algorithm using a single chain of the random walk WalkPolicy.
+// P has to be shifted so that the center of the inscribed ball is the origin.
+template <typename WalkPolicy, typename Polytope, typename Parameters, typename Point, typename NT>
+NT volume_sequence_of_balls(Polytope &P,
+                            Parameters &var,  // constans for volume
+                            const Point &c,   // center of the inscribed ball (origin)
+                            const NT &radius, // radius of the inscribed ball
+                            const unsigned int rnum)
+{
+    typedef Ball<Point> Ball;
+    typedef BallIntersectPolytope<Polytope,Ball> BallPoly;
+    typedef typename Parameters::RNGType RNGType;
+
+    bool print = var.verbose;
+    unsigned int n = var.n;
+    unsigned int walk_len = var.walk_steps;
+    NT vol = 0;
+
+    // 2. Generate the first random point in P
+    // Perform random walk on random point in the Chebychev ball
+    #ifdef VOLESTI_DEBUG
+    if(print) std::cout<<"\nGenerate the first random point in P"<<std::endl;
+    #endif
+
+    Point p = get_point_on_Dsphere<RNGType , Point>(n, radius, var.rng);
+    PointStore<Point> randPoints(n, rnum); //ds for storing rand points
+    //use a large walk length e.g. 1000
+
+    rand_point_generator<WalkPolicy>(P, p, 1, 50*n, randPoints, var);
+    double tstart2 = (double)clock()/(double)CLOCKS_PER_SEC;
+
+
+    // 3. Sample "rnum" points from P
+    #ifdef VOLESTI_DEBUG
+    if(print) std::cout<<"\nCompute "<<rnum<<" random points in P"<<std::endl;
+    #endif
+    rand_point_generator<WalkPolicy>(P, p, rnum-1, walk_len, randPoints, var);
+
+    double tstop2 = (double)clock()/(double)CLOCKS_PER_SEC;
+    #ifdef VOLESTI_DEBUG
+    if(print) std::cout << "First random points construction time = " << tstop2 - tstart2 << std::endl;
+    #endif
+
+    // 4.  Construct the sequence of balls
+    // 4a. compute the radius of the largest ball
+    NT max_dist = randPoints.max_squared_norm();
+    max_dist=std::sqrt(max_dist);
+    #ifdef VOLESTI_DEBUG
+    if(print) std::cout<<"\nFurthest distance from Chebychev point= "<<max_dist<<std::endl;
+    #endif
+
+    //
+    // 4b. Number of balls
+    int nb1 = n * (std::log(radius)/std::log(2.0));
+    int nb2 = std::ceil(n * (std::log(max_dist)/std::log(2.0)));
+
+    #ifdef VOLESTI_DEBUG
+    if(print) std::cout<<"\nConstructing the sequence of balls"<<std::endl;
+    #endif
+
+    std::vector<Ball> balls;
+
+    for(int i=nb1; i<=nb2; ++i){
+
+        if(i==nb1){
+            balls.push_back(Ball(c,radius*radius));
+            vol = (std::pow(M_PI,n/2.0)*(std::pow(balls[0].radius(), n) ) ) / (tgamma(n/2.0+1));
+        }else{
+            balls.push_back(Ball(c,std::pow(std::pow(2.0,NT(i)/NT(n)),2)));
+        }
+
+    }
+    assert(!balls.empty());
+
+    #ifdef VOLESTI_DEBUG
+    if (print) std::cout<<"---------"<<std::endl;
+    #endif
+
+    // 5. Estimate Vol(P)
+
+    typename std::vector<Ball>::iterator bit2=balls.end();
+    bit2--;
+
+    while(bit2!=balls.begin()){
+
+        //each step starts with some random points in PBLarge stored in list "randPoints"
+        //these points have been generated in a previous step
+
+        BallPoly PBLarge(P,*bit2);
+        --bit2;
+        BallPoly PBSmall(P,*bit2);
+
+        #ifdef VOLESTI_DEBUG
+        if(print)
+            std::cout<<"("<<balls.end()-bit2<<"/"<<balls.end()-balls.begin()<<") Ball ratio radius="
+                    <<PBLarge.second().radius()<<","<<PBSmall.second().radius()<<std::endl;
+        #endif
+
+        // choose a point in PBLarge to be used to generate more rand points
+        Point p_gen = randPoints.get_point(0);
+
+        // num of points in PBSmall and PBLarge
+        unsigned int nump_PBLarge = randPoints.size();
+
+        #ifdef VOLESTI_DEBUG
+        if(print) std::cout<<"Points in PBLarge="<<randPoints.size()
+                          <<std::endl;
+        #endif
+
+        //keep the points in randPoints that fall in PBSmall
+        unsigned int nump_PBSmall = randPoints.keep_in_ball(PBSmall.second().squared_radius());
+
+        #ifdef VOLESTI_DEBUG
+        if(print) std::cout<<"Points in PBSmall="<<randPoints.size()
+                          <<"\nRatio= "<<NT(nump_PBLarge)/NT(nump_PBSmall)
+                         <<std::endl;
+        #endif
+
+        #ifdef VOLESTI_DEBUG
+        if(print) std::cout<<"Generate "<<rnum-nump_PBLarge<<  " more "
+                          <<std::endl;
+        #endif
+
+        //generate more random points in PBLarge to have "rnum" in total
+        rand_point_generator<WalkPolicy>(PBLarge,p_gen,rnum-nump_PBLarge,walk_len,randPoints,PBSmall,nump_PBSmall,var);
+
+        vol *= NT(rnum)/NT(nump_PBSmall);
+
+        #ifdef VOLESTI_DEBUG
+        if(print) std::cout<<nump_PBSmall<<"/"<<rnum<<" = "<<NT(rnum)/nump_PBSmall
+                          <<"\ncurrent_vol = "<<vol
+                        <<"\n--------------------------"<<std::endl;
+        #endif
+
+        //don't continue in pairs of balls that are almost inside P, i.e. ratio ~= 2
+    }
+    return vol;
+}
+
+
+// Select the random walk from the flags of var and estimate the volume of P with the sequence of balls algorithm
+template <typename Polytope, typename Parameters, typename Point, typename NT>
+NT volume_sequence_of_balls(Polytope &P,
+                            Parameters &var,  // constans for volume
+                            const Point &c,   // center of the inscribed ball (origin)
+                            const NT &radius, // radius of the inscribed ball
+                            const unsigned int rnum)
+{
+    if (var.ball_walk) return volume_sequence_of_balls<BallWalk>(P, var, c, radius, rnum);
+    if (var.cdhr_walk) return volume_sequence_of_balls<CDHRWalk>(P, var, c, radius, rnum);
+    if (var.rdhr_walk) return volume_sequence_of_balls<RDHRWalk>(P, var, c, radius, rnum);
+    return volume_sequence_of_balls<BilliardWalk>(P, var, c, radius, rnum);
+}
 
 
 template <typename Polytope, typename Parameters, typename Point, typename NT>
@@ -36,20 +195,15 @@ NT volume(Polytope &P,
           Parameters & var,  // constans for volume
           std::pair<Point,NT> InnerBall)  //Chebychev ball
 {
- 
-    typedef Ball<Point> Ball;
-    typedef BallIntersectPolytope<Polytope,Ball> BallPoly;
     typedef typename Parameters::RNGType RNGType;
     typedef typename Polytope::VT VT;
 
     bool round = var.round;
     bool print = var.verbose;
-    bool rand_only = var.rand_only, deltaset = false;
     unsigned int n = var.n;
     unsigned int rnum = var.m;
     unsigned int walk_len = var.walk_steps;
-    unsigned int n_threads = var.n_threads;
-    const NT err = var.err;
+    unsigned int n_threads = std::max(var.n_threads, 1u);
     RNGType &rng = var.rng;
 
     //0. Get the Chebychev ball (largest inscribed ball) with center and radius
@@ -78,149 +232,45 @@ NT volume(Polytope &P,
     }
 
     // Move the chebychev center to the origin and apply the same shifting to the polytope
-    VT c_e = Eigen::Map<VT>(&c.get_coeffs()[0], c.dimension());
+    VT c_e = c.map();
     P.shift(c_e);
     c=Point(n);
 
     rnum=rnum/n_threads;
     NT vol=0;
-        
-    // Perform the procedure for a number of threads and then take the average
-    for(unsigned int t=0; t<n_threads; t++){
-        // 2. Generate the first random point in P
-        // Perform random walk on random point in the Chebychev ball
-        #ifdef VOLESTI_DEBUG
-        if(print) std::cout<<"\nGenerate the first random point in P"<<std::endl;
-        #endif
-        
-        Point p = get_point_on_Dsphere<RNGType , Point>(n, radius);
-        std::list<Point> randPoints; //ds for storing rand points
-        //use a large walk length e.g. 1000
-
-        rand_point_generator(P, p, 1, 50*n, randPoints, var);
-        double tstart2 = (double)clock()/(double)CLOCKS_PER_SEC;
-        
-        
-        // 3. Sample "rnum" points from P
-        #ifdef VOLESTI_DEBUG
-        if(print) std::cout<<"\nCompute "<<rnum<<" random points in P"<<std::endl;
-        #endif
-        rand_point_generator(P, p, rnum-1, walk_len, randPoints, var);
-        
-        double tstop2 = (double)clock()/(double)CLOCKS_PER_SEC;
-        #ifdef VOLESTI_DEBUG
-        if(print) std::cout << "First random points construction time = " << tstop2 - tstart2 << std::endl;
-        #endif
 
-        // 4.  Construct the sequence of balls
-        // 4a. compute the radius of the largest ball
-        NT current_dist, max_dist=NT(0);
-        for(typename  std::list<Point>::iterator pit=randPoints.begin(); pit!=randPoints.end(); ++pit){
-            current_dist=(*pit).squared_length();
-            if(current_dist>max_dist){
-                max_dist=current_dist;
-            }
+    if (n_threads == 1) {
+        vol = volume_sequence_of_balls(P, var, c, radius, rnum);
+    } else {
+        // Each worker owns a copy of P, its own random generator and its own point list.
+        // The streams are derived from one seed drawn from var.rng before any worker starts,
+        // so the estimate depends only on the state of var.rng and the number of threads.
+        // With VOLESTI_LPSOLVE_ORACLES V-polytopes and zonotopes share their lp_solve buffers among copies,
+        // so use a single thread with these bodies.
+        std::vector<Polytope> polys(n_threads, P);
+        std::vector<RNGType> rngs;
+        std::vector<Parameters> vars_t;
+        std::vector<NT> vols(n_threads, NT(0));
+        std::vector<std::thread> workers;
+
+        rngs.reserve(n_threads);
+        vars_t.reserve(n_threads);
+        const uint64_t base_seed = rng();
+        for (unsigned int t = 0; t < n_threads; t++) rngs.push_back(get_rng_stream<RNGType>(base_seed, t));
+        for (unsigned int t = 0; t < n_threads; t++) vars_t.push_back(Parameters(var, rngs[t]));
+
+        for (unsigned int t = 0; t < n_threads; t++) {
+            workers.push_back(std::thread([&, t]() {
+                vols[t] = volume_sequence_of_balls(polys[t], vars_t[t], c, radius, rnum);
+            }));
         }
-        max_dist=std::sqrt(max_dist);
-        #ifdef VOLESTI_DEBUG
-        if(print) std::cout<<"\nFurthest distance from Chebychev point= "<<max_dist<<std::endl;
-        #endif
-
-        //
-        // 4b. Number of balls
-        int nb1 = n * (std::log(radius)/std::log(2.0));
-        int nb2 = std::ceil(n * (std::log(max_dist)/std::log(2.0)));
-
-        #ifdef VOLESTI_DEBUG
-        if(print) std::cout<<"\nConstructing the sequence of balls"<<std::endl;
-        #endif
-
-        std::vector<Ball> balls;
-        
-        for(int i=nb1; i<=nb2; ++i){
-
-            if(i==nb1){
-                balls.push_back(Ball(c,radius*radius));
-                vol = (std::pow(M_PI,n/2.0)*(std::pow(balls[0].radius(), n) ) ) / (tgamma(n/2.0+1));
-            }else{
-                balls.push_back(Ball(c,std::pow(std::pow(2.0,NT(i)/NT(n)),2)));
-            }
-
-        }
-        assert(!balls.empty());
-
-        #ifdef VOLESTI_DEBUG
-        if (print) std::cout<<"---------"<<std::endl;
-        #endif
-
-        // 5. Estimate Vol(P)
-
-        typename std::vector<Ball>::iterator bit2=balls.end();
-        bit2--;
-
-        while(bit2!=balls.begin()){
-
-            //each step starts with some random points in PBLarge stored in list "randPoints"
-            //these points have been generated in a previous step
-
-            BallPoly PBLarge(P,*bit2);
-            --bit2;
-            BallPoly PBSmall(P,*bit2);
-
-            #ifdef VOLESTI_DEBUG
-            if(print)
-                std::cout<<"("<<balls.end()-bit2<<"/"<<balls.end()-balls.begin()<<") Ball ratio radius="
-                        <<PBLarge.second().radius()<<","<<PBSmall.second().radius()<<std::endl;
-            #endif
+        for (unsigned int t = 0; t < n_threads; t++) workers[t].join();
 
-            // choose a point in PBLarge to be used to generate more rand points
-            Point p_gen = *randPoints.begin();
-
-            // num of points in PBSmall and PBLarge
-            unsigned int nump_PBSmall = 0;
-            unsigned int nump_PBLarge = randPoints.size();
-
-            #ifdef VOLESTI_DEBUG
-            if(print) std::cout<<"Points in PBLarge="<<randPoints.size()
-                              <<std::endl;
-            #endif
-
-            //keep the points in randPoints that fall in PBSmall
-            typename std::list<Point>::iterator rpit=randPoints.begin();
-            while(rpit!=randPoints.end()){
-                if (PBSmall.second().is_in(*rpit) == 0){//not in
-                    rpit=randPoints.erase(rpit);
-                } else {
-                    ++nump_PBSmall;
-                    ++rpit;
-                }
-            }
-
-            #ifdef VOLESTI_DEBUG
-            if(print) std::cout<<"Points in PBSmall="<<randPoints.size()
-                              <<"\nRatio= "<<NT(nump_PBLarge)/NT(nump_PBSmall)
-                             <<std::endl;
-            #endif
-
-            #ifdef VOLESTI_DEBUG
-            if(print) std::cout<<"Generate "<<rnum-nump_PBLarge<<  " more "
-                              <<std::endl;
-            #endif
-
-            //generate more random points in PBLarge to have "rnum" in total
-            rand_point_generator(PBLarge,p_gen,rnum-nump_PBLarge,walk_len,randPoints,PBSmall,nump_PBSmall,var);
-
-            vol *= NT(rnum)/NT(nump_PBSmall);
-
-            #ifdef VOLESTI_DEBUG
-            if(print) std::cout<<nump_PBSmall<<"/"<<rnum<<" = "<<NT(rnum)/nump_PBSmall
-                              <<"\ncurrent_vol = "<<vol
-                            <<"\n--------------------------"<<std::endl;
-            #endif
-
-            //don't continue in pairs of balls that are almost inside P, i.e. ratio ~= 2
-        }
+        // Take the average of the estimations in thread order
+        for (unsigned int t = 0; t < n_threads; t++) vol += vols[t];
+        vol = vol / NT(n_threads);
     }
+
     vol=round_value*vol;
     #ifdef VOLESTI_DEBUG
     if(print) std::cout<<"rand points = "<<rnum<<std::endl;
@@ -235,10 +285,66 @@ NT volume(Polytope &P,
 
 
 
+// Estimate the ratio of the integrals over P of the gaussians exp(-a_next |x|^2) and exp(-a |x|^2), i.e. the
+// mean of exp(-a_next |x|^2) / exp(-a |x|^2) over the points x of the chain walk from p, which samples
+// from the gaussian a. Stop when the values of the ratio in the last W steps lie in an interval of
+// relative length curr_eps/2. fn and its accumulate the sum of the values and the number of steps
+template <typename Walk, typename Polytope, typename Point, typename NT, typename GParameters>
+NT esti_gaussian_ratio(Polytope &P, Walk &walk, Point &p, const NT &a, const NT &a_next, const NT &curr_eps,
+                       const unsigned int &W, const GParameters &var, NT &fn, NT &its) {
+
+    const NT maxNT = 1.79769e+308;
+    const NT minNT = -1.79769e+308;
+    unsigned int min_index = W-1, max_index = W-1, index = 0, min_steps = 0;
+    NT min_val = minNT, max_val = maxNT, val;
+    bool done = false;
+    std::vector<NT> last_W(W, 0);
+    typename std::vector<NT>::iterator minmaxIt;
+
+    while(!done || its<min_steps){
+
+        walk.apply(P, p, a, var.walk_steps, var);
+
+        its = its + 1.0;
+        fn = fn + eval_exp(p,a_next) / eval_exp(p,a);
+        val = fn / its;
+
+        last_W[index] = val;
+        if(val<=min_val){
+            min_val = val;
+            min_index = index;
+        }else if(min_index==index){
+            minmaxIt = std::min_element(last_W.begin(), last_W.end());
+            min_val = *minmaxIt;
+            min_index = std::distance(last_W.begin(), minmaxIt);
+        }
+
+        if(val>=max_val){
+            max_val = val;
+            max_index = index;
+        }else if(max_index==index){
+            minmaxIt = std::max_element(last_W.begin(), last_W.end());
+            max_val = *minmaxIt;
+            max_index = std::distance(last_W.begin(), minmaxIt);
+        }
+
+        if( (max_val-min_val)/max_val<=curr_eps/2.0 ){
+            done=true;
+        }
+
+        index = index%W+1;
+
+        if(index==W) index=0;
+    }
+    return fn / its;
+}
+
+
 // Implementation is based on algorithm from paper "A practical volume algorithm",
 // Springer-Verlag Berlin Heidelberg and The Mathematical Programming Society 2015
 // Ben Cousins, Santosh Vempala
-template <typename Polytope, typename UParameters, typename GParameters, typename Point, typename NT>
+// The gaussians are sampled with the random walk WalkPolicy (see gaussian_samplers.h).
+template <typename WalkPolicy, typename Polytope, typename UParameters, typename GParameters, typename Point, typename NT>
 NT volume_gaussian_annealing(Polytope &P,
                              GParameters & var,  // constans for volume
                              UParameters & var2,
@@ -246,16 +352,14 @@ NT volume_gaussian_annealing(Polytope &P,
     //typedef typename Polytope::MT 	MT;
     typedef typename Polytope::VT 	VT;
     typedef typename UParameters::RNGType RNGType;
-    const NT maxNT = 1.79769e+308;
-    const NT minNT = -1.79769e+308;
     NT vol;
-    bool round = var.round, done;
+    bool round = var.round;
     bool print = var.verbose;
     bool rand_only = var.rand_only, deltaset = false;
     unsigned int n = var.n, steps;
-    unsigned int walk_len = var.walk_steps, m = P.num_of_hyperplanes();
-    unsigned int n_threads = var.n_threads, min_index, max_index, index, min_steps;
-    NT error = var.error, curr_eps, min_val, max_val, val;
+    unsigned int walk_len = var.walk_steps;
+    unsigned int n_threads = var.n_threads;
+    NT error = var.error, curr_eps;
     NT frac = var.frac;
     RNGType &rng = var.rng;
     typedef typename std::vector<NT>::iterator viterator;
@@ -288,7 +392,7 @@ NT volume_gaussian_annealing(Polytope &P,
     var.che_rad = radius;
 
     // Move the chebychev center to the origin and apply the same shifting to the polytope
-    VT c_e = Eigen::Map<VT>(&c.get_coeffs()[0], c.dimension());
+    VT c_e = c.map();
     P.shift(c_e);
 
     // Initialization for the schedule annealing
@@ -302,7 +406,7 @@ NT volume_gaussian_annealing(Polytope &P,
     if(print) std::cout<<"\n\nComputing annealing...\n"<<std::endl;
     #endif
     double tstart2 = (double)clock()/(double)CLOCKS_PER_SEC;
-    get_annealing_schedule(P, radius, ratio, C, frac, N, var, error, a_vals);
+    get_annealing_schedule<WalkPolicy>(P, radius, ratio, C, frac, N, var, error, a_vals);
     double tstop2 = (double)clock()/(double)CLOCKS_PER_SEC;
     #ifdef VOLESTI_DEBUG
     if(print) std::cout<<"All the variances of schedule_annealing computed in = "<<tstop2-tstart2<<" sec"<<std::endl;
@@ -320,77 +424,61 @@ NT volume_gaussian_annealing(Polytope &P,
     #endif
 
     // Initialization for the approximation of the ratios
-    unsigned int W = var.W, coord_prev, i=0;
-    std::vector<NT> last_W2(W,0), fn(mm,0), its(mm,0), lamdas(m,0);
+    typedef typename WalkPolicy::template Walk<Polytope, Point, GParameters> Walk;
+    unsigned int W = var.W, i=0;
+    std::vector<NT> fn(mm,0), its(mm,0);
     vol=std::pow(M_PI/a_vals[0], (NT(n))/2.0)*std::abs(round_value);
-    Point p(n), p_prev(n); // The origin is the Chebychev center of the Polytope
-    viterator fnIt = fn.begin(), itsIt = its.begin(), avalsIt = a_vals.begin(), minmaxIt;
+    curr_eps = error/std::sqrt((NT(mm)));
 
     #ifdef VOLESTI_DEBUG
     if(print) std::cout<<"volume of the first gaussian = "<<vol<<"\n"<<std::endl;
     if(print) std::cout<<"computing ratios..\n"<<std::endl;
     #endif
 
-    // Compute the first point if CDHR is requested
-    if(var.cdhr_walk){
-        gaussian_first_coord_point(P,p,p_prev,coord_prev,var.walk_steps,*avalsIt,lamdas,var);
-    }
-    for ( ; fnIt != fn.end(); fnIt++, itsIt++, avalsIt++, i++) { //iterate over the number of ratios
-        //initialize convergence test
-        curr_eps = error/std::sqrt((NT(mm)));
-        done=false;
-        min_val = minNT;
-        max_val = maxNT;
-        min_index = W-1;
-        max_index = W-1;
-        index = 0;
-        min_steps=0;
-        std::vector<NT> last_W=last_W2;
-
-        // Set the radius for the ball walk if it is requested
-        if (var.ball_walk) {
-            var.delta = 4.0 * radius / std::sqrt(std::max(NT(1.0), *avalsIt) * NT(n));
-        }
-
-        while(!done || (*itsIt)<min_steps){
-
-            gaussian_next_point(P,p,p_prev,coord_prev,var.walk_steps,*avalsIt,lamdas,var);
-
-            *itsIt = *itsIt + 1.0;
-            *fnIt = *fnIt + eval_exp(p,*(avalsIt+1)) / eval_exp(p,*avalsIt);
-            val = (*fnIt) / (*itsIt);
+    if (n_threads <= 1) {
+        // Compute the first point. The same chain is used for all the ratios
+        Point p(n); // The origin is the Chebychev center of the Polytope
+        Walk walk(P, p, a_vals[0], var);
+        walk.apply(P, p, a_vals[0], var.walk_steps - 1, var);
 
-            last_W[index] = val;
-            if(val<=min_val){
-                min_val = val;
-                min_index = index;
-            }else if(min_index==index){
-                minmaxIt = std::min_element(last_W.begin(), last_W.end());
-                min_val = *minmaxIt;
-                min_index = std::distance(last_W.begin(), minmaxIt);
+        for (i = 0; i < mm; i++) {
+            // Set the radius for the ball walk if it is requested
+            if (var.ball_walk) {
+                var.delta = 4.0 * radius / std::sqrt(std::max(NT(1.0), a_vals[i]) * NT(n));
             }
-
-            if(val>=max_val){
-                max_val = val;
-                max_index = index;
-            }else if(max_index==index){
-                minmaxIt = std::max_element(last_W.begin(), last_W.end());
-                max_val = *minmaxIt;
-                max_index = std::distance(last_W.begin(), minmaxIt);
-            }
-
-            if( (max_val-min_val)/max_val<=curr_eps/2.0 ){
-                done=true;
+            esti_gaussian_ratio(P, walk, p, a_vals[i], a_vals[i+1], curr_eps, W, var, fn[i], its[i]);
+        }
+    } else {
+        // Every ratio has its own chain, started from the Chebychev center (the origin) by a pre-walk of
+        // n points at its gaussian, and the threads share the ratios (see run_tasks()). Every thread has
+        // its own copy of P and every ratio its own random stream, derived from one seed drawn from var.rng,
+        // so the estimate does not depend on the number of threads
+        std::vector<Polytope> polys(std::min(n_threads, mm), P);
+        std::vector<RNGType> rngs;
+        std::vector<GParameters> vars_t;
+        rngs.reserve(mm);
+        vars_t.reserve(mm);
+        const uint64_t base_seed = rng();
+        for (i = 0; i < mm; i++) rngs.push_back(get_rng_stream<RNGType>(base_seed, i));
+        for (i = 0; i < mm; i++) vars_t.push_back(GParameters(var, rngs[i]));
+
+        run_tasks(mm, n_threads, [&](const unsigned int k, const unsigned int t) {
+            GParameters &vark = vars_t[k];
+            if (vark.ball_walk) {
+                vark.delta = 4.0 * radius / std::sqrt(std::max(NT(1.0), a_vals[k]) * NT(n));
             }
+            Point p(n);
+            Walk walk(polys[t], p, a_vals[k], vark);
+            walk.apply(polys[t], p, a_vals[k], n * vark.walk_steps - 1, vark);
+            esti_gaussian_ratio(polys[t], walk, p, a_vals[k], a_vals[k+1], curr_eps, W, vark, fn[k], its[k]);
+        });
+    }
 
-            index = index%W+1;
-
-            if(index==W) index=0;
-        }
+    for (i = 0; i < mm; i++) {
         #ifdef VOLESTI_DEBUG
-        if(print) std::cout<<"ratio "<<i<<" = "<<(*fnIt) / (*itsIt)<<" N_"<<i<<" = "<<*itsIt<<std::endl;
+        if(print) std::cout<<"ratio "<<i<<" = "<<fn[i] / its[i]<<" N_"<<i<<" = "<<its[i]<<std::endl;
         #endif
-        vol = vol*((*fnIt) / (*itsIt));
+        vol = vol*(fn[i] / its[i]);
     }
     // Compute and print total number of steps in verbose mode only
     #ifdef VOLESTI_DEBUG
@@ -409,4 +497,49 @@ NT volume_gaussian_annealing(Polytope &P,
 }
 
 
+// Select the random walk from the flags of var and estimate the volume of P with gaussian cooling
+template <typename Polytope, typename UParameters, typename GParameters, typename Point, typename NT>
+NT volume_gaussian_annealing(Polytope &P,
+                             GParameters & var,  // constans for volume
+                             UParameters & var2,
+                             std::pair<Point,NT> InnerBall) {
+
+    if (var.ball_walk) return volume_gaussian_annealing<GaussianBallWalk>(P, var, var2, InnerBall);
+    if (var.cdhr_walk) return volume_gaussian_annealing<GaussianCDHRWalk>(P, var, var2, InnerBall);
+    return volume_gaussian_annealing<GaussianRDHRWalk>(P, var, var2, InnerBall);
+}
+
+
+// Estimates the volume of the H-polytope {x : Ax<=b} with points of fixed dimension D
+template <typename MT, typename VT, typename Parameters>
+struct hpoly_volume_fixed_dim {
+    typedef typename VT::Scalar result_type;
+
+    hpoly_volume_fixed_dim(const MT &A, const VT &b, Parameters &var) : A(A), b(b), var(var) {}
+
+    template <int D>
+    result_type apply() {
+        typedef typename Cartesian<result_type, D>::Point Point;
+        HPolytope<Point> P;
+        P.init(A.cols(), A, b);
+        std::pair<Point, result_type> InnerBall = P.ComputeInnerBall();
+        return volume(P, var, InnerBall);
+    }
+
+    const MT &A;
+    const VT &b;
+    Parameters &var;
+};
+
+
+// Volume of the H-polytope {x : Ax<=b}. If the dimension is one of Dims the polytope, the points and the
+// walks are instantiated for that dimension at compile time, otherwise the dynamic ones are used,
+// e.g. volume_fixed_dimension<2, 3, 4, 5, 6, 7, 8>(A, b, var)
+template <int... Dims, typename MT, typename VT, typename Parameters>
+typename VT::Scalar volume_fixed_dimension(const MT &A, const VT &b, Parameters &var) {
+    hpoly_volume_fixed_dim<MT, VT, Parameters> f(A, b, var);
+    return dimension_dispatch<Dims...>::run(A.cols(), f);
+}
+
+
 #endif
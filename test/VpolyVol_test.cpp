@@ -15,6 +15,7 @@
 #include "volume.h"
 #include "known_polytope_generators.h"
 #include <typeinfo>
+#include <thread>
 
 template <typename NT>
 NT factorial(NT n)
@@ -121,6 +122,102 @@ void call_test_simplex() {
 
 }
 
+template <typename NT>
+void call_test_redundant_vertices(unsigned int n_threads) {
+    typedef Cartesian<NT>    Kernel;
+    typedef typename Kernel::Point    Point;
+    typedef boost::mt19937    RNGType;
+    typedef VPolytope<Point, RNGType > Vpolytope;
+    typedef typename Vpolytope::MT MT;
+    typedef typename Vpolytope::VT VT;
+
+    std::cout << "--- Testing redundant vertices of V-cube4 with " << n_threads << " threads" << std::endl;
+    Vpolytope P = gen_cube<Vpolytope>(4, true);
+    MT V = P.get_mat();
+    int k = V.rows();
+
+    // the cube with points in its interior, on its facets and edges and a duplicate vertex
+    RNGType rng(5);
+    boost::random::uniform_real_distribution<> urdist(-1, 1);
+    MT V2(k + 41, 4);
+    V2.topRows(k) = V;
+    for (int i = 0; i < 40; i++) {
+        for (int j = 0; j < 4; j++) V2(k + i, j) = urdist(rng);
+        if (i % 4 == 1) V2(k + i, 0) = 1.0;
+        if (i % 4 == 2) V2.block(k + i, 0, 1, 3) = V.block(i % k, 0, 1, 3);
+    }
+    V2.row(k + 40) = V.row(3);
+
+    P.init(4, V2, VT::Ones(k + 41));
+    CHECK(P.remove_redundant_vertices(n_threads) == 41);
+    CHECK(P.num_of_vertices() == k);
+    CHECK(P.get_mat().topRows(k) == V);
+}
+
+
+template <typename NT>
+void call_test_concurrent_oracles(unsigned int n_threads) {
+    typedef Cartesian<NT>    Kernel;
+    typedef typename Kernel::Point    Point;
+    typedef boost::mt19937    RNGType;
+    typedef VPolytope<Point, RNGType > Vpolytope;
+
+    std::cout << "--- Testing the oracles of V-cross5 from " << n_threads << " threads" << std::endl;
+    Vpolytope P = gen_cross<Vpolytope>(5, true);
+    unsigned int n = 5, N = 200;
+
+    RNGType rng(5);
+    boost::normal_distribution<> rdist(0,1);
+    std::vector<Point> points, dirs;
+    for (unsigned int i = 0; i < N; i++) {
+        Point p(n), v(n);
+        for (unsigned int j = 0; j < n; j++) {
+            p.set_coord(j, 0.5 * rdist(rng));
+            v.set_coord(j, rdist(rng));
+        }
+        points.push_back(p);
+        dirs.push_back(v);
+    }
+
+    // every thread queries the same polytope and a copy of it
+    Vpolytope P2 = P;
+    std::vector<std::vector<int> > in(n_threads, std::vector<int>(N)), in2(n_threads, std::vector<int>(N));
+    std::vector<std::vector<NT> > chords(n_threads, std::vector<NT>(N));
+    std::vector<std::thread> workers;
+    for (unsigned int t = 0; t < n_threads; t++) {
+        workers.push_back(std::thread([&, t]() {
+            for (unsigned int i = 0; i < N; i++) {
+                in[t][i] = P.is_in(points[i]);
+                std::pair<NT,NT> res = P.line_intersect(points[i], dirs[i]);
+                chords[t][i] = res.first - res.second;
+                in2[t][i] = P2.is_in(points[i]);
+            }
+        }));
+    }
+    for (unsigned int t = 0; t < n_threads; t++) workers[t].join();
+    P2.free_them_all();
+
+    // the l1 ball: the membership is exact and the chords are compared with the ones of the main thread
+    unsigned int diff = 0;
+    NT max_err = 0.0;
+    for (unsigned int i = 0; i < N; i++) {
+        NT l1 = 0.0;
+        for (unsigned int j = 0; j < n; j++) l1 += std::abs(points[i][j]);
+        std::pair<NT,NT> res = P.line_intersect(points[i], dirs[i]);
+        for (unsigned int t = 0; t < n_threads; t++) {
+            if (in2[t][i] != in[t][i]) diff++;
+            if (l1 < 1.0 - 1e-8 && in[t][i] != -1) diff++;
+            if (l1 > 1.0 + 1e-8 && in[t][i] != 0) diff++;
+            if (l1 < 1.0 - 1e-8) max_err = std::max(max_err, std::abs(chords[t][i] - (res.first - res.second)));
+        }
+    }
+    P.free_them_all();
+    P.free_them_all();
+    CHECK(diff == 0);
+    CHECK(max_err < 1e-8);
+}
+
+
 TEST_CASE("cube") {
     call_test_cube<double>();
     //call_test_cube<float>();
@@ -138,3 +235,12 @@ TEST_CASE("simplex") {
     //call_test_simplex<float>();
     //call_test_simplex<long double>();
 }
+
+TEST_CASE("redundant_vertices") {
+    call_test_redundant_vertices<double>(1);
+    call_test_redundant_vertices<double>(3);
+}
+
+TEST_CASE("concurrent_oracles") {
+    call_test_concurrent_oracles<double>(4);
+}
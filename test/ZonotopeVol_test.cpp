@@ -15,6 +15,7 @@
 #include "volume.h"
 #include "z_polytopes_gen.h"
 #include "exact_vols.h"
+#include "zonotope_facets.h"
 #include <typeinfo>
 
 template <typename NT>
@@ -73,6 +74,39 @@ void test_zono_volume(int n, int m, NT tolerance = 0.15)
 }
 
 
+template <typename NT>
+void test_zono_facets(int n, int m)
+{
+    typedef Cartesian<NT>    Kernel;
+    typedef typename Kernel::Point    Point;
+    typedef boost::mt19937    RNGType;
+    typedef Zonotope<Point> Zonotope;
+    Zonotope ZP = gen_zonotope_uniform<Zonotope, RNGType>(n, m);
+
+    std::cout << "--- Testing facets of Zonotope in dimension: " << n <<" and number of generators: "<< m << std::endl;
+    HPolytope<Point> HP;
+    CHECK(zonotope_as_hpoly(ZP, HP));
+
+    // generators in general position: every (n-1)-subset spans a facet
+    NT num_of_facets = 2 * factorial<NT>(m) / (factorial<NT>(n - 1) * factorial<NT>(m - n + 1));
+    CHECK(HP.num_of_hyperplanes() == int(num_of_facets));
+
+    RNGType rng(5);
+    boost::normal_distribution<> rdist(0,1);
+    NT scale = ZP.get_mat().cwiseAbs().colwise().sum().maxCoeff() / 2.0;
+    unsigned int diff = 0;
+    for (unsigned int i = 0; i < 1000; i++) {
+        Point p(n);
+        for (unsigned int j = 0; j < n; j++) p.set_coord(j, scale * rdist(rng));
+        if ((HP.is_in(p) == -1) != (ZP.is_in(p) == -1)) diff++;
+    }
+    CHECK(diff == 0);
+
+    ZP.set_max_hpoly_facets(num_of_facets - 1);
+    CHECK(!zonotope_as_hpoly(ZP, HP));
+}
+
+
 template <typename NT>
 void call_test(int n, int m){
     test_zono_volume<NT>(n, m);
@@ -84,3 +118,7 @@ TEST_CASE("4_dimensional") {
     //call_test<float>(4,8);
     //call_test<long double>(4,8);
 }
+
+TEST_CASE("4_dimensional_facets") {
+    test_zono_facets<double>(4, 8);
+}
@@ -39,7 +39,8 @@ NT factorial(NT n)
 }
 
 template <typename NT, class RNGType, class Polytope>
-void test_cool_bodies(Polytope &HP, NT expected, NT tolerance=0.1, bool round = false, NT diam = -1.0)
+void test_cool_bodies(Polytope &HP, NT expected, NT tolerance=0.1, bool round = false, NT diam = -1.0,
+                      int n_threads=1)
 {
 
     typedef typename Polytope::PolytopePoint Point;
@@ -47,7 +48,7 @@ void test_cool_bodies(Polytope &HP, NT expected, NT tolerance=0.1, bool round =
     // Setup the parameters
     int n = HP.dimension();
     int walk_len=3;
-    int nexp=1, n_threads=1;
+    int nexp=1;
     NT e=0.1, err=0.0000000001, diameter = diam, round_val = 1.0;
     int rnum = std::pow(e,-2) * 400 * n * std::log(n);
     unsigned seed = std::chrono::system_clock::now().time_since_epoch().count();
@@ -125,6 +126,19 @@ void call_test_cube(){
     test_cool_bodies<NT, RNGType>(P, 1073742000.0);
 }
 
+template <typename NT>
+void call_test_cube_threads(){
+    typedef Cartesian<NT>    Kernel;
+    typedef typename Kernel::Point    Point;
+    typedef boost::mt19937    RNGType;
+    typedef HPolytope<Point> Hpolytope;
+    Hpolytope P;
+
+    std::cout << "--- Testing volume of H-cube20 with 4 threads" << std::endl;
+    P = gen_cube<Hpolytope>(20, false);
+    test_cool_bodies<NT, RNGType>(P, 1048576.0, 0.1, false, -1.0, 4);
+}
+
 template <typename NT>
 void call_test_cross(){
     typedef Cartesian<NT>    Kernel;
@@ -256,6 +270,10 @@ call_test_cube<double>();
 //call_test_cube<long double>();
 }
 
+TEST_CASE("cube_threads") {
+call_test_cube_threads<double>();
+}
+
 TEST_CASE("cross") {
 call_test_cross<double>();
 //call_test_cross<float>();
@@ -0,0 +1,120 @@
+// VolEsti (volume computation and sampling library)
+
+// Copyright (c) 20012-2019 Vissarion Fisikopoulos
+// Copyright (c) 2018-2019 Apostolos Chalkis
+
+// Licensed under GNU LGPL.3, see LICENCE file
+
+#include "doctest.h"
+#include <unistd.h>
+#include "Eigen/Eigen"
+#include "random.hpp"
+#include "random/uniform_int.hpp"
+#include "random/normal_distribution.hpp"
+#include "random/uniform_real_distribution.hpp"
+#include "volume.h"
+#include "zonoIntersecthpoly.h"
+#include "known_polytope_generators.h"
+#include "z_polytopes_gen.h"
+#include <typeinfo>
+
+template <typename NT, class Polytope>
+void test_diameter(Polytope &P, NT expected, NT tolerance=0.00001)
+{
+    NT diam;
+    P.comp_diam(diam, 0.0);
+
+    NT error = std::abs(diam - expected) / expected;
+    std::cout << "Estimated diameter = " << diam << std::endl;
+    std::cout << "Expected diameter = " << expected << std::endl;
+            CHECK(error < tolerance);
+}
+
+template <typename NT>
+void call_test_hpoly(){
+    typedef Cartesian<NT>    Kernel;
+    typedef typename Kernel::Point    Point;
+    typedef HPolytope<Point> Hpolytope;
+    Hpolytope P;
+
+    std::cout << "--- Testing diameter of H-cube10" << std::endl;
+    P = gen_cube<Hpolytope>(10, false);
+    test_diameter<NT>(P, 2.0 * std::sqrt(10.0));
+
+    std::cout << "--- Testing diameter of H-simplex10" << std::endl;
+    P = gen_simplex<Hpolytope>(10, false);
+    test_diameter<NT>(P, std::sqrt(2.0));
+
+    std::cout << "--- Testing diameter of H-skinny_cube10" << std::endl;
+    P = gen_skinny_cube<Hpolytope>(10);
+    test_diameter<NT>(P, std::sqrt(4.0 * 9.0 + 200.0 * 200.0));
+
+    std::cout << "--- Testing diameter of H-cross5" << std::endl;
+    P = gen_cross<Hpolytope>(5, false);
+    test_diameter<NT>(P, 2.0);
+}
+
+template <typename NT>
+void call_test_vpoly(){
+    typedef Cartesian<NT>    Kernel;
+    typedef typename Kernel::Point    Point;
+    typedef boost::mt19937    RNGType;
+    typedef VPolytope<Point, RNGType > Vpolytope;
+    Vpolytope P;
+
+    std::cout << "--- Testing diameter of V-cube8" << std::endl;
+    P = gen_cube<Vpolytope>(8, true);
+    test_diameter<NT>(P, 2.0 * std::sqrt(8.0));
+
+    std::cout << "--- Testing diameter of V-cross10" << std::endl;
+    P = gen_cross<Vpolytope>(10, true);
+    test_diameter<NT>(P, 2.0);
+
+    std::cout << "--- Testing diameter of V-simplex10" << std::endl;
+    P = gen_simplex<Vpolytope>(10, true);
+    test_diameter<NT>(P, std::sqrt(2.0));
+}
+
+template <typename NT>
+void call_test_zonotope(){
+    typedef Cartesian<NT>    Kernel;
+    typedef typename Kernel::Point    Point;
+    typedef boost::mt19937    RNGType;
+    typedef Zonotope<Point> zonotope;
+    typedef HPolytope<Point> Hpolytope;
+    typedef typename zonotope::MT MT;
+    typedef typename zonotope::VT VT;
+
+    std::cout << "--- Testing diameter of zonotope_4_10" << std::endl;
+    zonotope P = gen_zonotope_uniform<zonotope, RNGType>(4, 10, 7);
+
+    // a zonotope is symmetric, so its diameter is twice the largest norm of its vertices
+    MT V = P.get_mat();
+    int k = V.rows();
+    NT max_norm = 0.0;
+    VT s(k);
+    for (int m = 0; m < (1 << k); ++m) {
+        for (int i = 0; i < k; ++i) s(i) = ((m >> i) & 1) ? 1.0 : -1.0;
+        max_norm = std::max(max_norm, (V.transpose() * s).norm());
+    }
+    test_diameter<NT>(P, 2.0 * max_norm);
+
+    std::cout << "--- Testing diameter of zonotope_4_10 intersected with a cube" << std::endl;
+    Hpolytope HP = gen_cube<Hpolytope>(4, false);
+    VT b = HP.get_vec() * 2.0;
+    HP.set_vec(b);
+    ZonoIntersectHPoly<zonotope, Hpolytope> ZHP(P, HP);
+    test_diameter<NT>(ZHP, 8.0);
+}
+
+TEST_CASE("hpoly") {
+    call_test_hpoly<double>();
+}
+
+TEST_CASE("vpoly") {
+    call_test_vpoly<double>();
+}
+
+TEST_CASE("zonotope") {
+    call_test_zonotope<double>();
+}
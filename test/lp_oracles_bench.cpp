@@ -0,0 +1,170 @@
+// VolEsti (volume computation and sampling library)
+
+// Copyright (c) 20012-2019 Vissarion Fisikopoulos
+// Copyright (c) 2018-2019 Apostolos Chalkis
+
+// Licensed under GNU LGPL.3, see LICENCE file
+
+// Compare the LP oracles of V-polytopes and zonotopes:
+//  - lp_solve, a new model in every query,
+//  - lp_solve, persistent models,
+//  - DenseLP, the dense simplex of dense_lp.h.
+// The queries are the points and directions of a hit-and-run walk, as in the samplers.
+
+#include "Eigen/Eigen"
+#include <chrono>
+#include <cstring>
+#include "cartesian_geom/cartesian_kernel.h"
+#include "random.hpp"
+#include "random/uniform_int.hpp"
+#include "random/normal_distribution.hpp"
+#include "random/uniform_real_distribution.hpp"
+#include "vpolyoracles.h"
+#include "zpolyoracles.h"
+#include "vpolytope.h"
+#include "zpolytope.h"
+#include "v_polytopes_gen.h"
+#include "z_polytopes_gen.h"
+
+typedef double NT;
+typedef Cartesian<NT> Kernel;
+typedef Kernel::Point Point;
+typedef boost::mt19937 RNGType;
+typedef Eigen::Matrix<NT, Eigen::Dynamic, Eigen::Dynamic> MT;
+typedef Eigen::Matrix<NT, Eigen::Dynamic, 1> VT;
+
+
+double elapsed(const std::chrono::steady_clock::time_point &start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+
+void bench(const MT &V, const bool zonotope, const unsigned int N, RNGType &rng) {
+
+    unsigned int d = V.cols(), k = V.rows();
+    boost::normal_distribution<> rdist(0, 1);
+    boost::random::uniform_real_distribution<> urdist(0, 1);
+
+    // the queries: the points and directions of a hit-and-run walk and the points of a ball walk around them
+    DenseLP<NT> ray, mem;
+    ray_Vpoly_model(V, ray, zonotope);
+    if (zonotope) {
+        memLP_Zonotope_model(V, mem);
+    } else {
+        memLP_Vpoly_model(V, mem);
+    }
+    std::pair<NT, NT> bpair, res;
+    std::vector<Point> points, dirs, queries;
+    Point p(d), v(d);
+    for (unsigned int i = 0; i < N; ++i) {
+        for (unsigned int j = 0; j < d; ++j) v.set_coord(j, rdist(rng));
+        v *= 1.0 / std::sqrt(v.squared_length());
+        points.push_back(p);
+        dirs.push_back(v);
+        bpair = zonotope ? intersect_line_zono(ray, p, v) : intersect_double_line_Vpoly(ray, p, v);
+        queries.push_back(p);
+        queries.back().axpy(1.2 * bpair.first, v);
+        p.axpy(bpair.second + urdist(rng) * (bpair.first - bpair.second), v);
+    }
+
+    std::vector<REAL> row(k + 2);
+    std::vector<int> colno(k + 2);
+    std::vector<std::pair<NT, NT> > chords(N);
+    std::vector<bool> in(N);
+    unsigned int mem_diff;
+    NT max_err;
+    std::chrono::steady_clock::time_point start;
+    double t_ray, t_mem;
+
+    // lp_solve, a new model in every query
+    start = std::chrono::steady_clock::now();
+    for (unsigned int i = 0; i < N; ++i) {
+        chords[i] = zonotope ? intersect_line_zono(V, points[i], dirs[i], row.data(), colno.data()) :
+                    intersect_double_line_Vpoly<NT>(V, points[i], dirs[i], row.data(), colno.data());
+    }
+    t_ray = elapsed(start);
+    start = std::chrono::steady_clock::now();
+    for (unsigned int i = 0; i < N; ++i) {
+        in[i] = zonotope ? memLP_Zonotope(V, queries[i], row.data(), colno.data()) :
+                memLP_Vpoly(V, queries[i], row.data(), colno.data());
+    }
+    t_mem = elapsed(start);
+    std::cout << "lp_solve, new model      : ray-shooting " << t_ray << " sec, membership " << t_mem << " sec\n";
+
+    // lp_solve, persistent models
+    lp_model ray_lp = ray_Vpoly_model(V, row.data(), colno.data(), zonotope);
+    lp_model mem_lp = zonotope ? memLP_Zonotope_model(V, row.data(), colno.data()) :
+                      memLP_Vpoly_model(V, row.data(), colno.data());
+    max_err = 0.0;
+    mem_diff = 0;
+    start = std::chrono::steady_clock::now();
+    for (unsigned int i = 0; i < N; ++i) {
+        res = zonotope ? intersect_line_zono(ray_lp.get(), points[i], dirs[i], row.data(), colno.data()) :
+              intersect_double_line_Vpoly(ray_lp.get(), points[i], dirs[i], row.data(), colno.data());
+        max_err = std::max(max_err, std::abs(res.first - chords[i].first) + std::abs(res.second - chords[i].second));
+    }
+    t_ray = elapsed(start);
+    start = std::chrono::steady_clock::now();
+    for (unsigned int i = 0; i < N; ++i) {
+        bool is_in = zonotope ? memLP_Zonotope(mem_lp.get(), queries[i]) :
+                     memLP_Vpoly(mem_lp.get(), queries[i], row.data(), colno.data());
+        if (is_in != in[i]) mem_diff++;
+    }
+    t_mem = elapsed(start);
+    std::cout << "lp_solve, persistent     : ray-shooting " << t_ray << " sec, membership " << t_mem << " sec"
+              << ", max chord difference " << max_err << ", membership differences " << mem_diff << "\n";
+
+    // DenseLP
+    max_err = 0.0;
+    mem_diff = 0;
+    start = std::chrono::steady_clock::now();
+    for (unsigned int i = 0; i < N; ++i) {
+        res = zonotope ? intersect_line_zono(ray, points[i], dirs[i]) : intersect_double_line_Vpoly(ray, points[i], dirs[i]);
+        max_err = std::max(max_err, std::abs(res.first - chords[i].first) + std::abs(res.second - chords[i].second));
+    }
+    t_ray = elapsed(start);
+    start = std::chrono::steady_clock::now();
+    for (unsigned int i = 0; i < N; ++i) {
+        bool is_in = zonotope ? memLP_Zonotope(mem, queries[i]) : memLP_Vpoly(mem, queries[i]);
+        if (is_in != in[i]) mem_diff++;
+    }
+    t_mem = elapsed(start);
+    std::cout << "DenseLP                  : ray-shooting " << t_ray << " sec, membership " << t_mem << " sec"
+              << ", max chord difference " << max_err << ", membership differences " << mem_diff << "\n";
+}
+
+
+int main(const int argc, const char** argv) {
+
+    unsigned int d = 10, k = 100, N = 1000;
+    bool zonotope = false;
+    for (int i = 1; i < argc; ++i) {
+        if (!strcmp(argv[i], "-help")) {
+            std::cout << "Usage: lp_oracles_bench [-d dimension] [-k vertices or generators] [-N queries] "
+                      << "[-zonotope]" << std::endl;
+            return 0;
+        } else if (!strcmp(argv[i], "-d")) {
+            d = atoi(argv[++i]);
+        } else if (!strcmp(argv[i], "-k")) {
+            k = atoi(argv[++i]);
+        } else if (!strcmp(argv[i], "-N")) {
+            N = atoi(argv[++i]);
+        } else if (!strcmp(argv[i], "-zonotope")) {
+            zonotope = true;
+        }
+    }
+
+    RNGType rng(5);
+    if (zonotope) {
+        typedef Zonotope<Point> zonotope_t;
+        zonotope_t Z = gen_zonotope_uniform<zonotope_t, RNGType>(d, k, 5);
+        std::cout << "Zonotope, d = " << d << ", generators = " << k << ", queries = " << N << std::endl;
+        bench(Z.get_mat(), true, N, rng);
+    } else {
+        typedef VPolytope<Point, RNGType> vpolytope_t;
+        vpolytope_t P = random_vpoly<vpolytope_t, RNGType>(d, k, 5);
+        std::cout << "V-polytope, d = " << d << ", vertices = " << k << ", queries = " << N << std::endl;
+        bench(P.get_mat(), false, N, rng);
+    }
+    return 0;
+}
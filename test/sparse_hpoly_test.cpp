@@ -0,0 +1,229 @@
+// VolEsti (volume computation and sampling library)
+
+// Copyright (c) 20012-2019 Vissarion Fisikopoulos
+// Copyright (c) 2018-2019 Apostolos Chalkis
+
+// Licensed under GNU LGPL.3, see LICENCE file
+
+#include "doctest.h"
+#include <unistd.h>
+#include "Eigen/Eigen"
+#include "random.hpp"
+#include "random/uniform_int.hpp"
+#include "random/normal_distribution.hpp"
+#include "random/uniform_real_distribution.hpp"
+#include "volume.h"
+#include "cooling_balls.h"
+#include "known_polytope_generators.h"
+#include <typeinfo>
+
+template <typename NT>
+NT factorial(NT n)
+{
+    return (n == 1 || n == 0) ? 1 : factorial(n - 1) * n;
+}
+
+template <typename NT, class RNGType, class Polytope>
+void test_volume(Polytope &P, NT expected, bool round = false, NT tolerance=0.1)
+{
+
+    typedef typename Polytope::PolytopePoint Point;
+
+    // Setup the parameters
+    int n = P.dimension();
+    int walk_len=10 + n/10;
+    int n_threads=1;
+    NT e=1, err=0.0000000001;
+    int rnum = std::pow(e,-2) * 400 * n * std::log(n);
+    unsigned seed = std::chrono::system_clock::now().time_since_epoch().count();
+    RNGType rng(seed);
+    boost::random::uniform_real_distribution<>(urdist);
+    boost::random::uniform_real_distribution<> urdist1(-1,1);
+
+    vars<NT, RNGType> var(rnum,n,walk_len,n_threads,err,e,0,0,0,0,0.0,rng,
+                          urdist,urdist1,-1.0,false,false,round,false,false,false,true,false,false);
+
+    // Estimate the volume
+    std::cout << "Number type: " << typeid(NT).name() << std::endl;
+    NT vol = 0;
+    unsigned int const num_of_exp = 5;
+    Polytope P2 = P;
+    for (unsigned int i=0; i<num_of_exp; i++)
+    {
+        P = P2;
+        std::pair<Point,NT> CheBall = P.ComputeInnerBall();
+        vol += volume(P,var,CheBall);
+    }
+    NT error = std::abs(((vol/num_of_exp)-expected))/expected;
+    std::cout << "Computed volume (average) = " << vol/num_of_exp << std::endl;
+    std::cout << "Expected volume = " << expected << std::endl;
+            CHECK(error < tolerance);
+}
+
+
+template <typename NT, class RNGType, class Polytope>
+void test_CG_volume(Polytope &P, NT expected, NT tolerance=0.3)
+{
+
+    typedef typename Polytope::PolytopePoint Point;
+
+    // Setup the parameters
+    int n = P.dimension();
+    int walk_len=3;
+    NT e=0.1, err=0.0000000001;
+    NT C=2.0,ratio,frac=0.1,delta=-1.0;
+    int rnum = std::pow(e,-2) * 400 * n * std::log(n);
+    int N = 500 * ((int) C) + ((int) (n * n / 2));
+    int W = 6*n*n+800;
+    ratio = 1.0-1.0/(NT(n));
+    unsigned seed = std::chrono::system_clock::now().time_since_epoch().count();
+    RNGType rng(seed);
+    boost::random::uniform_real_distribution<>(urdist);
+    boost::random::uniform_real_distribution<> urdist1(-1,1);
+
+    // Estimate the volume
+    std::cout << "Number type: " << typeid(NT).name() << std::endl;
+    NT vol = 0;
+    unsigned int const num_of_exp = 5;
+    Polytope P2 = P;
+    for (unsigned int i=0; i<num_of_exp; i++)
+    {
+        P = P2;
+        std::pair<Point,NT> CheBall = P.ComputeInnerBall();
+        vars<NT, RNGType> var2(rnum,n,10 + n/10,1,err,e,0,0,0,0,0.0,rng,
+                               urdist,urdist1,-1.0,false,false,false,false,false,false,true,false,false);
+        vars_g<NT, RNGType> var1(n,walk_len,N,W,1,e,CheBall.second,rng,C,frac,ratio,delta,
+                                 false,false,false,false,false,false,true,false);
+        vol += volume_gaussian_annealing(P, var1, var2, CheBall);
+    }
+    NT error = std::abs(((vol/num_of_exp)-expected))/expected;
+    std::cout << "Computed volume (average) = " << vol/num_of_exp << std::endl;
+    std::cout << "Expected volume = " << expected << std::endl;
+            CHECK(error < tolerance);
+}
+
+
+template <typename NT, class RNGType, class Polytope>
+void test_CB_volume(Polytope &P, NT expected, NT tolerance=0.2)
+{
+
+    typedef typename Polytope::PolytopePoint Point;
+
+    // Setup the parameters
+    int n = P.dimension();
+    int walk_len=1;
+    NT e=0.1, err=0.0000000001, diameter;
+    int rnum = std::pow(e,-2) * 400 * n * std::log(n);
+    unsigned seed = std::chrono::system_clock::now().time_since_epoch().count();
+    RNGType rng(seed);
+    boost::random::uniform_real_distribution<>(urdist);
+    boost::random::uniform_real_distribution<> urdist1(-1,1);
+
+    // Estimate the volume
+    std::cout << "Number type: " << typeid(NT).name() << std::endl;
+    NT vol = 0;
+    unsigned int const num_of_exp = 5;
+    Polytope P2 = P;
+    for (unsigned int i=0; i<num_of_exp; i++)
+    {
+        P = P2;
+        P.normalize();
+        std::pair<Point,NT> InnerBall = P.ComputeInnerBall();
+        P.comp_diam(diameter, InnerBall.second);
+        vars<NT, RNGType> var(rnum,n,walk_len,1,err,e,0,0,0,InnerBall.second,diameter,rng,
+                              urdist,urdist1,-1.0,false,false,false,false,false,false,false,false,true);
+        vars_ban <NT> var_ban(0.1, 0.15, 0.75, 0.0, 0.2, 500, 150, 10, false);
+        vol += vol_cooling_balls(P, var, var_ban, InnerBall);
+    }
+    NT error = std::abs(((vol/num_of_exp)-expected))/expected;
+    std::cout << "Computed volume (average) = " << vol/num_of_exp << std::endl;
+    std::cout << "Expected volume = " << expected << std::endl;
+            CHECK(error < tolerance);
+}
+
+
+template <typename NT>
+void call_test_cube(){
+    typedef Cartesian<NT>    Kernel;
+    typedef typename Kernel::Point    Point;
+    typedef boost::mt19937    RNGType;
+    typedef SparseHPolytope<Point> Hpolytope;
+    Hpolytope P;
+
+    std::cout << "--- Testing volume of sparse H-cube10" << std::endl;
+    P = gen_cube<Hpolytope>(10, false);
+    test_volume<NT, RNGType>(P, 1024);
+}
+
+template <typename NT>
+void call_test_prod_simplex(){
+    typedef Cartesian<NT>    Kernel;
+    typedef typename Kernel::Point    Point;
+    typedef boost::mt19937    RNGType;
+    typedef SparseHPolytope<Point> Hpolytope;
+    Hpolytope P;
+
+    std::cout << "--- Testing volume of sparse H-prod_simplex5" << std::endl;
+    P = gen_prod_simplex<Hpolytope>(5);
+    test_volume<NT, RNGType>(P, std::pow(1.0 / factorial(5.0), 2));
+}
+
+template <typename NT>
+void call_test_skinny_cube_round(){
+    typedef Cartesian<NT>    Kernel;
+    typedef typename Kernel::Point    Point;
+    typedef boost::mt19937    RNGType;
+    typedef SparseHPolytope<Point> Hpolytope;
+    Hpolytope P;
+
+    std::cout << "--- Testing volume of sparse H-skinny_cube10 with rounding" << std::endl;
+    P = gen_skinny_cube<Hpolytope>(10);
+    test_volume<NT, RNGType>(P, 102400, true);
+}
+
+template <typename NT>
+void call_test_CG_cube(){
+    typedef Cartesian<NT>    Kernel;
+    typedef typename Kernel::Point    Point;
+    typedef boost::mt19937    RNGType;
+    typedef SparseHPolytope<Point> Hpolytope;
+    Hpolytope P;
+
+    std::cout << "--- Testing volume of sparse H-cube10 with CG" << std::endl;
+    P = gen_cube<Hpolytope>(10, false);
+    test_CG_volume<NT, RNGType>(P, 1024);
+}
+
+template <typename NT>
+void call_test_CB_cube(){
+    typedef Cartesian<NT>    Kernel;
+    typedef typename Kernel::Point    Point;
+    typedef boost::mt19937    RNGType;
+    typedef SparseHPolytope<Point> Hpolytope;
+    Hpolytope P;
+
+    std::cout << "--- Testing volume of sparse H-cube10 with CB" << std::endl;
+    P = gen_cube<Hpolytope>(10, false);
+    test_CB_volume<NT, RNGType>(P, 1024);
+}
+
+
+TEST_CASE("cube") {
+    call_test_cube<double>();
+}
+
+TEST_CASE("prod_simplex") {
+    call_test_prod_simplex<double>();
+}
+
+TEST_CASE("skinny_cube_round") {
+    call_test_skinny_cube_round<double>();
+}
+
+TEST_CASE("CG_cube") {
+    call_test_CG_cube<double>();
+}
+
+TEST_CASE("CB_cube") {
+    call_test_CB_cube<double>();
+}
@@ -26,7 +26,7 @@ NT factorial(NT n)
 }
 
 template <typename NT, class RNGType, class Polytope>
-void test_CV_volume(Polytope &HP, NT expected, NT tolerance=0.3)
+void test_CV_volume(Polytope &HP, NT expected, NT tolerance=0.3, int n_threads=1)
 {
 
     typedef typename Polytope::PolytopePoint Point;
@@ -34,7 +34,7 @@ void test_CV_volume(Polytope &HP, NT expected, NT tolerance=0.3)
     // Setup the parameters
     int n = HP.dimension();
     int walk_len=3;
-    int nexp=1, n_threads=1;
+    int nexp=1;
     NT e=0.1, err=0.0000000001;
     NT C=2.0,ratio,frac=0.1,delta=-1.0;
     int rnum = std::pow(e,-2) * 400 * n * std::log(n);
@@ -60,7 +60,7 @@ void test_CV_volume(Polytope &HP, NT expected, NT tolerance=0.3)
         CheBall = HP.ComputeInnerBall();
         vars<NT, RNGType> var2(rnum,n,10 + n/10,n_threads,err,e,0,0,0,0,0.0,rng,
                  urdist,urdist1,-1.0,false,false,false,false,false,false,true,false,false);
-        vars_g<NT, RNGType> var1(n,walk_len,N,W,1,e,CheBall.second,rng,C,frac,ratio,delta,
+        vars_g<NT, RNGType> var1(n,walk_len,N,W,n_threads,e,CheBall.second,rng,C,frac,ratio,delta,
                     false,false,false,false,false,false,true,false);
         vol += volume_gaussian_annealing(HP, var1, var2, CheBall);
     }
@@ -93,6 +93,19 @@ void call_test_cube(){
 
 }
 
+template <typename NT>
+void call_test_cube_threads(){
+    typedef Cartesian<NT>    Kernel;
+    typedef typename Kernel::Point    Point;
+    typedef boost::mt19937    RNGType;
+    typedef HPolytope<Point> Hpolytope;
+    Hpolytope P;
+
+    std::cout << "--- Testing volume of H-cube20 with 4 threads" << std::endl;
+    P = gen_cube<Hpolytope>(20, false);
+    test_CV_volume<NT, RNGType>(P, 1048576.0, 0.3, 4);
+}
+
 template <typename NT>
 void call_test_cross(){
     typedef Cartesian<NT>    Kernel;
@@ -198,6 +211,10 @@ TEST_CASE("cube") {
     //call_test_cube<long double>();
 }
 
+TEST_CASE("cube_threads") {
+    call_test_cube_threads<double>();
+}
+
 TEST_CASE("cross") {
     call_test_cross<double>();
     //call_test_cross<float>();
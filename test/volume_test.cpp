@@ -25,7 +25,7 @@ NT factorial(NT n)
 }
 
 template <typename NT, class RNGType, class Polytope>
-void test_volume(Polytope &HP, NT expected, NT tolerance=0.1)
+void test_volume(Polytope &HP, NT expected, NT tolerance=0.1, int n_threads=1)
 {
 
     typedef typename Polytope::PolytopePoint Point;
@@ -33,7 +33,7 @@ void test_volume(Polytope &HP, NT expected, NT tolerance=0.1)
     // Setup the parameters
     int n = HP.dimension();
     int walk_len=10 + n/10;
-    int nexp=1, n_threads=1;
+    int nexp=1;
     NT e=1, err=0.0000000001;
     int rnum = std::pow(e,-2) * 400 * n * std::log(n);
     unsigned seed = std::chrono::system_clock::now().time_since_epoch().count();
@@ -85,6 +85,43 @@ void call_test_cube(){
     test_volume<NT, RNGType>(P, 1073742000.0, 0.2);
 }
 
+template <typename NT>
+void call_test_cube_threads(){
+    typedef Cartesian<NT>    Kernel;
+    typedef typename Kernel::Point    Point;
+    typedef boost::mt19937    RNGType;
+    typedef HPolytope<Point> Hpolytope;
+    Hpolytope P;
+
+    std::cout << "--- Testing volume of H-cube10 with 4 threads" << std::endl;
+    P = gen_cube<Hpolytope>(10, false);
+    test_volume<NT, RNGType>(P, 1024.0, 0.1, 4);
+}
+
+template <typename NT>
+void call_test_cube_fixed_dim(){
+    typedef Cartesian<NT, 10>    Kernel;
+    typedef typename Kernel::Point    Point;
+    typedef boost::mt19937    RNGType;
+    typedef HPolytope<Point> Hpolytope;
+    Hpolytope P;
+
+    std::cout << "--- Testing volume of H-cube10 with compile-time dimension" << std::endl;
+    P = gen_cube<Hpolytope>(10, false);
+    test_volume<NT, RNGType>(P, 1024.0);
+
+    std::cout << "--- Testing volume of H-cube10 with runtime dispatch" << std::endl;
+    unsigned seed = std::chrono::system_clock::now().time_since_epoch().count();
+    RNGType rng(seed);
+    boost::random::uniform_real_distribution<>(urdist);
+    boost::random::uniform_real_distribution<> urdist1(-1,1);
+    int n = 10, rnum = 400 * n * std::log(n);
+    vars<NT, RNGType> var(rnum,n,10 + n/10,1,0.0000000001,1,0,0,0,0,0.0,rng,
+                          urdist,urdist1,-1.0,false,false,false,false,false,false,true,false,false);
+    NT vol = volume_fixed_dimension<2, 10>(P.get_mat(), P.get_vec(), var);
+    CHECK(std::abs(vol - 1024.0) / 1024.0 < 0.2);
+}
+
 template <typename NT>
 void call_test_cross(){
     typedef Cartesian<NT>    Kernel;
@@ -216,6 +253,14 @@ TEST_CASE("cube") {
     //call_test_cube<long double>();
 }
 
+TEST_CASE("cube_threads") {
+    call_test_cube_threads<double>();
+}
+
+TEST_CASE("cube_fixed_dim") {
+    call_test_cube_fixed_dim<double>();
+}
+
 TEST_CASE("cross") {
     call_test_cross<double>();
     //call_test_cross<float>();
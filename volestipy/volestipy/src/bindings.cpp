@@ -96,16 +96,12 @@ void HPolytopeCPP::generate_samples(int walk_len, int n_samples, double* samples
    vars_g<NT, RNGType> var2(n,walk_len,N,W,1,epsilon_dummy,CheBall.second,rng,
       C,0.1,ratio,-1,false,false,false,false,false,false,false,true,false);
 
-   std::list <Point> randPoints;
+   PointStore<Point> randPoints(n, n_samples);
    bool gaussian_samples = false;
    double a_dummy = 1.0; //make this a parameter once gaussian_samples if a parameter too and can be true also.
 
    sampling_only<Point>(randPoints, HP, walk_len, n_samples, gaussian_samples, a_dummy, CheBall.first, var1, var2);
 
-   auto n_si=0;
-   for (auto it_s = randPoints.begin(); it_s != randPoints.end(); it_s++){
-      for (auto i = 0; i != it_s->dimension(); i++){
-         samples[n_si++] = (*it_s)[i];
-      }
-   }
+   // the store keeps the samples contiguously, i.e. as the rows of the n_samples x n output array
+   std::copy(randPoints.data(), randPoints.data() + randPoints.size() * n, samples);
 }